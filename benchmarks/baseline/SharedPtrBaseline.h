@@ -0,0 +1,325 @@
+#pragma once
+#include <cstddef>  // std::nullptr_t
+#include <utility>  // std::forward, std::move
+#include <atomic>   // std::atomic
+#include <new>      // placement new
+
+/*
+   Frozen copy of include/memory/SharedPtr.h before the refcount memory-order
+   and function-pointer control block changes (seq_cst counts, virtual
+   dispose/destroy). Kept only so the benchmarks have something to compare
+   against.
+*/
+
+namespace Baseline {
+
+    // --- Control Block ---
+    // Not exposed to the user.
+    struct ControlBlock {
+        std::atomic<long> refCount = 1;
+        std::atomic<long> weakCount = 1;
+
+        //Destroys the managed object (refCount hit 0)
+        virtual void dispose() = 0;
+        //Frees the control block (weakCount hit 0)
+        virtual void destroy() = 0;
+
+        //Virtual destructor
+        virtual ~ControlBlock() = default;
+
+        void release_strong() noexcept {
+            if (refCount.fetch_sub(1) == 1) {
+                dispose();
+                release_weak();
+            }
+        }
+        void release_weak() noexcept {
+            if (weakCount.fetch_sub(1) == 1) {
+                destroy();
+            }
+        }
+        // refCount + 1 unless it is already 0 (object gone).
+        bool try_acquire_strong() noexcept {
+            long count = refCount.load();
+            while (count != 0) {
+                if (refCount.compare_exchange_weak(count, count + 1)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    template<typename T>
+    struct DefaultControlBlock : ControlBlock {
+        T* managed_ptr_;
+
+        DefaultControlBlock(T* ptr) : managed_ptr_(ptr) {};
+
+        void dispose() override {
+            delete managed_ptr_;
+        };
+        void destroy() override {
+            delete this;
+        };
+    };
+
+    template<typename T>
+    struct AllocationBlock : ControlBlock {
+        //In a union so that dispose() can destroy it before the block is freed
+        union {
+            T object;
+        };
+
+        template<typename... Args>
+        AllocationBlock(Args&&... args) {
+            new (&object) T(std::forward<Args>(args)...);
+        };
+        ~AllocationBlock() override {};
+
+        void dispose() override {
+            object.~T();
+        };
+        void destroy() override {
+            delete this;
+        };
+    };
+
+    template<typename T>
+    class WeakPtr;
+
+    template<typename T>
+    class SharedPtr {
+    public:
+        // --- Constructors ---
+
+        // Default Constructor (Null)
+        constexpr SharedPtr() noexcept {
+            cb_ = nullptr;
+            ptr_ = nullptr;
+        };
+        constexpr SharedPtr(std::nullptr_t) noexcept;
+
+        // Constructor from raw pointer
+        // Requirement: Allocates a Control Block.
+        explicit SharedPtr(T* ptr) {
+            cb_ = new Baseline::DefaultControlBlock<T>(ptr);
+            ptr_ = ptr;
+        };
+
+
+        // Copy Constructor
+        // Requirement: Increments ref_count.
+        SharedPtr(const SharedPtr& other) noexcept {
+            ptr_ = other.ptr_;
+            cb_ = other.cb_;
+            if (cb_) {
+                cb_->refCount++;
+            }
+        };
+
+        // Move Constructor
+        // Requirement: Steals ownership. Ref_count remains unchanged.
+        SharedPtr(SharedPtr&& other) noexcept {
+            cb_ = other.cb_;
+            ptr_ = other.ptr_;
+
+            other.cb_ = nullptr;
+            other.ptr_ = nullptr;
+        };
+
+        // --- Destructor ---
+        // Requirement: Decrements ref_count. If 0, destroys object AND Control Block.
+        ~SharedPtr() {
+            release_ownership();
+        };
+
+        // --- Assignment Operators ---
+
+        // Copy Assignment
+        SharedPtr& operator=(const SharedPtr& other) noexcept {
+            if (other.cb_) {
+                other.cb_->refCount++;
+            }
+
+            release_ownership();
+
+            cb_ = other.cb_;
+            ptr_ = other.ptr_;
+
+            return *this;
+        };
+
+        // Move Assignment
+        SharedPtr& operator=(SharedPtr&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            release_ownership();
+
+
+            cb_ = other.cb_;
+            ptr_ = other.ptr_;
+
+            other.cb_ = nullptr;
+            other.ptr_ = nullptr;
+
+            return *this;
+
+        };
+
+        // --- Modifiers ---
+
+        // Replaces the managed object.
+        void reset() noexcept {
+            release_ownership();
+            ptr_ = nullptr;
+            cb_ = nullptr;
+        };
+        void reset(T* ptr) {
+            if (ptr == ptr_) {
+                return;
+            }
+
+            DefaultControlBlock<T>* temp_cb = nullptr;
+            if (ptr) {
+                temp_cb = new DefaultControlBlock<T>(ptr);
+            }
+
+            release_ownership();
+
+            ptr_ = ptr;
+            cb_ = temp_cb;
+        };
+
+        // --- Observers ---
+
+        T* get() const noexcept {
+            return ptr_;
+        };
+        T& operator*() const noexcept {
+            return *ptr_;
+        };
+        T* operator->() const noexcept {
+            return ptr_;
+        };
+
+        // Returns the current number of owners.
+        long use_count() const noexcept {
+            return (cb_ != nullptr) ? cb_->refCount.load() : 0;
+        };
+
+        explicit operator bool() const noexcept {
+            return (ptr_ != nullptr) ? true: false;
+        };
+
+    private:
+        // Constructor from raw pointer and cb
+        // This is dangerous to allow a user to use it
+        explicit SharedPtr(T* ptr, ControlBlock* cb) {
+            ptr_ = ptr;
+            cb_ = cb;
+        };
+
+        // Hint: You need access to the control block for make_shared logic
+        template<typename U, typename... Args>
+        friend SharedPtr<U> make_shared(Args&&... args);
+
+        friend class WeakPtr<T>;
+
+        void release_ownership() noexcept {
+            if (cb_) {
+                cb_->release_strong();
+            }
+        };
+
+        ControlBlock* cb_ = nullptr;
+        T* ptr_= nullptr;
+    };
+
+    // --- Factory Function ---
+    // Requirement: Performs ONE memory allocation for both the Object and the Control Block.
+    template<typename T, typename... Args>
+    SharedPtr<T> make_shared(Args&&... args) {
+
+        AllocationBlock<T>* ac = new AllocationBlock<T>(std::forward<Args>(args)...);
+
+        return SharedPtr(&ac->object, ac);
+    };
+
+    // --- WeakPtr ---
+    // Observes a SharedPtr's object without keeping it alive.
+    template<typename T>
+    class WeakPtr {
+    public:
+        constexpr WeakPtr() noexcept = default;
+
+        WeakPtr(const SharedPtr<T>& shared) noexcept:
+            cb_(shared.cb_), ptr_(shared.ptr_)
+        {
+            if (cb_) {
+                cb_->weakCount++;
+            }
+        };
+
+        WeakPtr(const WeakPtr& other) noexcept:
+            cb_(other.cb_), ptr_(other.ptr_)
+        {
+            if (cb_) {
+                cb_->weakCount++;
+            }
+        };
+        WeakPtr(WeakPtr&& other) noexcept:
+            cb_(std::exchange(other.cb_, nullptr)), ptr_(std::exchange(other.ptr_, nullptr))
+        {};
+
+        ~WeakPtr() {
+            if (cb_) {
+                cb_->release_weak();
+            }
+        };
+
+        WeakPtr& operator=(const WeakPtr& other) noexcept {
+            WeakPtr(other).swap(*this);
+            return *this;
+        };
+        WeakPtr& operator=(WeakPtr&& other) noexcept {
+            WeakPtr(std::move(other)).swap(*this);
+            return *this;
+        };
+        WeakPtr& operator=(const SharedPtr<T>& shared) noexcept {
+            WeakPtr(shared).swap(*this);
+            return *this;
+        };
+
+        void reset() noexcept {
+            WeakPtr().swap(*this);
+        };
+        void swap(WeakPtr& other) noexcept {
+            std::swap(cb_, other.cb_);
+            std::swap(ptr_, other.ptr_);
+        };
+
+        // A SharedPtr to the object, or an empty one if it is already gone.
+        // Safe to call while other threads drop the last owner.
+        SharedPtr<T> lock() const noexcept {
+            if (cb_ && cb_->try_acquire_strong()) {
+                return SharedPtr<T>(ptr_, cb_);
+            }
+            return SharedPtr<T>();
+        };
+
+        long use_count() const noexcept {
+            return (cb_ != nullptr) ? cb_->refCount.load() : 0;
+        };
+        bool expired() const noexcept {
+            return use_count() == 0;
+        };
+
+    private:
+        ControlBlock* cb_ = nullptr;
+        T* ptr_ = nullptr;
+    };
+
+}
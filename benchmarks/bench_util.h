@@ -0,0 +1,148 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+    Small helpers shared by the benchmark executables.
+
+    * No external dependencies: we time with steady_clock and, on Linux, read
+    hardware counters through perf_event_open when the kernel lets us
+    * Numbers are only meaningful from an optimised build on an idle machine
+    * The output is one row per case so runs can be diffed by eye
+*/
+
+namespace Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    // Stops the optimiser from discarding a value we computed only to time it.
+    template<typename T>
+    inline void do_not_optimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline double elapsed_ns(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    // Pins the calling thread to one core so producer/consumer really run on
+    // different cores. Best effort: silently does nothing if it fails.
+    inline void pin_thread(unsigned cpu) {
+#if defined(__linux__)
+        const unsigned ncpu = std::thread::hardware_concurrency();
+        if (ncpu == 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % ncpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpu;
+#endif
+    }
+
+    // Counts a hardware event (cache misses by default) for this process and
+    // every thread it starts after start(). valid() is false when the kernel
+    // or the VM does not expose the PMU; callers then print "n/a".
+    class PerfCounter {
+    public:
+        explicit PerfCounter(uint64_t config = 3 /* PERF_COUNT_HW_CACHE_MISSES */) {
+#if defined(__linux__)
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+            (void)config;
+#endif
+        }
+
+        ~PerfCounter() {
+#if defined(__linux__)
+            if (fd_ >= 0) {
+                close(fd_);
+            }
+#endif
+        }
+
+        PerfCounter(const PerfCounter&) = delete;
+        PerfCounter& operator=(const PerfCounter&) = delete;
+
+        bool valid() const noexcept { return fd_ >= 0; }
+
+        void start() {
+#if defined(__linux__)
+            if (fd_ >= 0) {
+                ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        uint64_t stop() {
+            uint64_t count = 0;
+#if defined(__linux__)
+            if (fd_ >= 0) {
+                ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                    count = 0;
+                }
+            }
+#endif
+            return count;
+        }
+
+    private:
+        int fd_ = -1;
+    };
+
+    // Iteration count from argv[1] if given, otherwise the default. Handy for
+    // quick smoke runs on small or shared machines.
+    inline uint64_t iterations(int argc, char** argv, uint64_t fallback) {
+        if (argc > 1) {
+            const uint64_t n = std::strtoull(argv[1], nullptr, 10);
+            if (n > 0) {
+                return n;
+            }
+        }
+        return fallback;
+    }
+
+    // One line per case: name, ns per op and millions of ops per second.
+    inline void report(const char* name, double ns_per_op) {
+        std::printf("%-44s %10.2f ns/op %10.2f Mops/s\n", name, ns_per_op, 1e3 / ns_per_op);
+    }
+
+    // Same, plus cache misses per op from a PerfCounter ("n/a" without a PMU).
+    inline void report(const char* name, double ns_per_op, const PerfCounter& counter,
+                       uint64_t count, uint64_t ops) {
+        if (!counter.valid()) {
+            std::printf("%-44s %10.2f ns/op %10.2f Mops/s %14s\n",
+                        name, ns_per_op, 1e3 / ns_per_op, "misses/op n/a");
+        }
+        else {
+            std::printf("%-44s %10.2f ns/op %10.2f Mops/s %10.3f misses/op\n",
+                        name, ns_per_op, 1e3 / ns_per_op, static_cast<double>(count) / ops);
+        }
+    }
+}
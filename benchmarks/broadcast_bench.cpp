@@ -0,0 +1,124 @@
+#include "bench_util.h"
+#include "queues/BroadcastRing.h"
+#include "queues/SpscRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*
+    Fan-out of one feed to N readers.
+
+    * per_reader_spsc: today's approach, one SpscRing per reader and the
+    producer pushes every message N times
+    * broadcast: one BroadcastRing, the producer writes once, every reader
+    reads the slot in place (peek/advance)
+    * Reported: wall time per message (all readers done), and the producer's
+    share of that, as N grows. Payload is a 64-byte struct
+*/
+
+namespace {
+
+    constexpr size_t kRingSize = 4096;
+    uint64_t g_messages = 5'000'000;
+
+    struct Payload {
+        uint64_t seq;
+        uint64_t fields[7];
+    };
+
+    void report_case(const char* shape, unsigned readers, double wall_ns, double producer_ns) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s/%u_readers", shape, readers);
+        Bench::report(name, wall_ns / g_messages);
+        std::printf("%-44s %10.2f ns/msg on the producer\n", "", producer_ns / g_messages);
+    }
+
+    void per_reader_spsc(unsigned readers) {
+        std::vector<std::unique_ptr<My::SpscRing<Payload>>> rings;
+        for (unsigned r = 0; r < readers; ++r) {
+            rings.push_back(std::make_unique<My::SpscRing<Payload>>(kRingSize));
+        }
+
+        std::vector<std::thread> threads;
+        for (unsigned r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r]() {
+                Bench::pin_thread(1 + r);
+                Payload p;
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < g_messages; ++i) {
+                    while (!rings[r]->pop(p)) {}
+                    sum += p.seq;
+                }
+                Bench::do_not_optimize(sum);
+            });
+        }
+
+        Bench::pin_thread(0);
+        const auto start = Bench::Clock::now();
+        Payload p{};
+        for (uint64_t i = 0; i < g_messages; ++i) {
+            p.seq = i;
+            for (unsigned r = 0; r < readers; ++r) {
+                while (!rings[r]->push(p)) {}
+            }
+        }
+        const auto produced = Bench::Clock::now();
+        for (auto& t : threads) {
+            t.join();
+        }
+        const auto end = Bench::Clock::now();
+        report_case("per_reader_spsc", readers, Bench::elapsed_ns(start, end), Bench::elapsed_ns(start, produced));
+    }
+
+    void broadcast(unsigned readers) {
+        My::BroadcastRing<Payload> ring(kRingSize, readers);
+
+        std::vector<std::thread> threads;
+        for (unsigned r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r]() {
+                Bench::pin_thread(1 + r);
+                auto reader = ring.reader(r);
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < g_messages; ++i) {
+                    const Payload* p;
+                    while ((p = reader.peek()) == nullptr) {}
+                    sum += p->seq;
+                    reader.advance();
+                }
+                Bench::do_not_optimize(sum);
+            });
+        }
+
+        Bench::pin_thread(0);
+        const auto start = Bench::Clock::now();
+        Payload p{};
+        for (uint64_t i = 0; i < g_messages; ++i) {
+            p.seq = i;
+            while (!ring.push(p)) {}
+        }
+        const auto produced = Bench::Clock::now();
+        for (auto& t : threads) {
+            t.join();
+        }
+        const auto end = Bench::Clock::now();
+        report_case("broadcast", readers, Bench::elapsed_ns(start, end), Bench::elapsed_ns(start, produced));
+    }
+}
+
+int main(int argc, char** argv) {
+    g_messages = Bench::iterations(argc, argv, g_messages);
+    const unsigned max_readers = std::max(1u, std::thread::hardware_concurrency() - 1);
+
+    std::printf("--- %zu-byte payload, ring size %zu, up to %u readers ---\n",
+                sizeof(Payload), kRingSize, max_readers);
+    for (unsigned n = 1; n <= max_readers; n *= 2) {
+        per_reader_spsc(n);
+        broadcast(n);
+    }
+    return 0;
+}
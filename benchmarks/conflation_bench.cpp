@@ -0,0 +1,136 @@
+#include "bench_util.h"
+#include "queues/ConflationQueue.h"
+#include "queues/SpscRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+/*
+    ConflationQueue under a producer burst.
+
+    * The consumer spends kWorkNs on every message; the producer publishes
+    quotes for kKeys instruments ten times faster than that
+    * Reported per quarter of the run: mean consumer latency (now minus the
+    timestamp of the value it received) and the deepest backlog seen
+    * FIFO: the same feed through a plain SpscRing big enough to never fill.
+    Its backlog and latency grow for as long as the burst lasts; the
+    conflated ones stay bounded by the number of keys
+*/
+
+namespace {
+
+    constexpr int kKeys = 256;
+    constexpr int64_t kWorkNs = 1000;
+    constexpr int64_t kProducerGapNs = kWorkNs / 10;
+    uint64_t g_updates = 200'000;
+
+    struct Quote {
+        int64_t sent_at;
+        double bid;
+        double ask;
+    };
+
+    struct KeyedQuote {
+        int key;
+        Quote quote;
+    };
+
+    int64_t now_ns() {
+        return Bench::Clock::now().time_since_epoch().count();
+    }
+
+    void spin_for(int64_t ns) {
+        const int64_t until = now_ns() + ns;
+        while (now_ns() < until) {}
+    }
+
+    struct Quarter {
+        double latency_sum = 0;
+        uint64_t count = 0;
+        size_t max_backlog = 0;
+    };
+
+    void print_quarters(const char* name, const Quarter (&quarters)[4]) {
+        for (int q = 0; q < 4; ++q) {
+            char label[64];
+            std::snprintf(label, sizeof(label), "%s/q%d", name, q + 1);
+            const double mean = quarters[q].count ? quarters[q].latency_sum / quarters[q].count : 0.0;
+            std::printf("%-44s %12.0f ns latency %10zu max backlog\n", label, mean, quarters[q].max_backlog);
+        }
+    }
+
+    // Runs producer and consumer; Push/Pop/Depth adapt the queue under test.
+    template<typename Push, typename Pop, typename Depth>
+    void run(const char* name, Push push, Pop pop, Depth depth) {
+        Quarter quarters[4];
+        std::atomic<bool> done = false;
+        std::atomic<int> quarter = 0;
+
+        std::thread consumer([&]() {
+            Bench::pin_thread(1);
+            Quote quote;
+            while (true) {
+                const bool finished = done.load(std::memory_order_acquire);
+                if (pop(quote)) {
+                    Quarter& q = quarters[quarter.load(std::memory_order_relaxed)];
+                    q.latency_sum += static_cast<double>(now_ns() - quote.sent_at);
+                    q.count++;
+                    spin_for(kWorkNs);
+                }
+                else if (finished) {
+                    break;
+                }
+            }
+        });
+
+        Bench::pin_thread(0);
+        for (uint64_t i = 0; i < g_updates; ++i) {
+            const int q = static_cast<int>(i * 4 / g_updates);
+            quarter.store(q, std::memory_order_relaxed);
+            const double px = 100.0 + static_cast<double>(i % 100) * 0.01;
+            push(static_cast<int>(i % kKeys), Quote{now_ns(), px, px + 0.01});
+            quarters[q].max_backlog = std::max(quarters[q].max_backlog, depth());
+            spin_for(kProducerGapNs);
+        }
+        done.store(true, std::memory_order_release);
+        consumer.join();
+
+        print_quarters(name, quarters);
+    }
+}
+
+int main(int argc, char** argv) {
+    g_updates = Bench::iterations(argc, argv, g_updates);
+    std::printf("--- %d keys, consumer %lld ns/msg, producer every %lld ns (10x burst) ---\n",
+                kKeys, static_cast<long long>(kWorkNs), static_cast<long long>(kProducerGapNs));
+
+    {
+        My::ConflationQueue<int, Quote> queue(kKeys);
+        run("conflated",
+            [&](int key, const Quote& quote) { queue.push(key, quote); },
+            [&](Quote& quote) { int key; return queue.pop(key, quote); },
+            [&]() { return queue.size(); });
+        std::printf("%-44s %10llu pushed %10llu conflated %10llu delivered\n", "conflated/counters",
+                    static_cast<unsigned long long>(queue.pushed()),
+                    static_cast<unsigned long long>(queue.conflated()),
+                    static_cast<unsigned long long>(queue.delivered()));
+    }
+    {
+        My::SpscRing<KeyedQuote> fifo(g_updates);
+        run("fifo",
+            [&](int key, const Quote& quote) { fifo.push(KeyedQuote{key, quote}); },
+            [&](Quote& quote) {
+                KeyedQuote item;
+                if (!fifo.pop(item)) {
+                    return false;
+                }
+                quote = item.quote;
+                return true;
+            },
+            [&]() { return fifo.size(); });
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "bench_util.h"
+#include "queues/MpmcQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*
+    MpmcQueue contention scaling.
+
+    * P producers and C consumers share one queue; every producer pushes the
+    same number of messages, consumers drain until all have been seen
+    * Reported: wall time per message, total throughput and throughput per
+    core (total / (P + C)); the per-core number is what falls off as the
+    cursors get contended
+    * Run with single push/pop and with 16-item bulk calls
+*/
+
+namespace {
+
+    constexpr size_t kQueueSize = 4096;
+    constexpr size_t kBatch = 16;
+    uint64_t g_messages = 10'000'000;
+
+    template<bool Bulk>
+    void contention(unsigned producers, unsigned consumers) {
+        My::MpmcQueue<uint64_t> queue(kQueueSize);
+        const uint64_t per_producer = g_messages / producers;
+        const uint64_t total = per_producer * producers;
+        std::atomic<uint64_t> received = 0;
+        std::atomic<bool> go = false;
+
+        std::vector<std::thread> threads;
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c]() {
+                Bench::pin_thread(producers + c);
+                while (!go.load(std::memory_order_acquire)) {}
+                uint64_t batch[kBatch];
+                uint64_t sum = 0;
+                while (received.load(std::memory_order_relaxed) < total) {
+                    const size_t n = Bulk ? queue.pop_bulk(batch, kBatch) : (queue.pop(batch[0]) ? 1 : 0);
+                    for (size_t i = 0; i < n; ++i) {
+                        sum += batch[i];
+                    }
+                    if (n != 0) {
+                        received.fetch_add(n, std::memory_order_relaxed);
+                    }
+                }
+                Bench::do_not_optimize(sum);
+            });
+        }
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                Bench::pin_thread(p);
+                while (!go.load(std::memory_order_acquire)) {}
+                uint64_t batch[kBatch];
+                for (uint64_t i = 0; i < per_producer;) {
+                    if constexpr (Bulk) {
+                        const size_t want = static_cast<size_t>(std::min<uint64_t>(kBatch, per_producer - i));
+                        for (size_t k = 0; k < want; ++k) {
+                            batch[k] = i + k;
+                        }
+                        size_t sent = 0;
+                        while (sent < want) {
+                            sent += queue.push_bulk(batch + sent, want - sent);
+                        }
+                        i += want;
+                    }
+                    else {
+                        while (!queue.push(i)) {}
+                        ++i;
+                    }
+                }
+            });
+        }
+
+        const auto start = Bench::Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads) {
+            t.join();
+        }
+        const auto end = Bench::Clock::now();
+
+        const double ns = Bench::elapsed_ns(start, end);
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s/%uP_%uC", Bulk ? "bulk_16" : "single", producers, consumers);
+        Bench::report(name, ns / total);
+        std::printf("%-44s %10.2f Mops/s per core\n", "", total / (ns / 1e3) / (producers + consumers));
+    }
+}
+
+int main(int argc, char** argv) {
+    g_messages = Bench::iterations(argc, argv, g_messages);
+    const unsigned max_side = std::max(1u, std::thread::hardware_concurrency() / 2);
+
+    std::printf("--- MpmcQueue<uint64_t>, queue size %zu, up to %u producers/consumers ---\n",
+                kQueueSize, max_side);
+    for (unsigned n = 1; n <= max_side; n *= 2) {
+        contention<false>(n, n);
+    }
+    for (unsigned n = 1; n <= max_side; n *= 2) {
+        contention<true>(n, n);
+    }
+    // Fan-in and fan-out shapes at the widest setting
+    if (max_side > 1) {
+        contention<false>(max_side, 1);
+        contention<false>(1, max_side);
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "bench_util.h"
+#include "analytics/RollingWindow.h"
+#include "queues/CircularBuffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+/*
+    RollingWindow against a full recompute, per tick.
+
+    * Each tick pushes one price and reads sum, mean, variance, min and max
+    * recompute: CircularBuffer in Overwrite mode, then two passes over
+    as_spans() (sum/min/max, then squared deviations). O(window) per tick
+    * incremental: RollingWindow<double, RollingSum, RollingMoments, RollingMin,
+    RollingMax>. O(1) per tick (amortised for min/max)
+    * The window is filled before timing. Recompute gets fewer ticks at large
+    windows so the run stays short; the cost is reported per tick either way
+*/
+
+namespace {
+
+    uint64_t g_ticks = 1'000'000;
+
+    struct Stats {
+        double sum, mean, variance, min, max;
+    };
+
+    std::vector<double> make_prices(size_t count) {
+        std::mt19937_64 rng(7);
+        std::normal_distribution<double> step(0.0, 0.01);
+        std::vector<double> prices(count);
+        double p = 100.0;
+        for (double& x : prices) {
+            p += step(rng);
+            x = p;
+        }
+        return prices;
+    }
+
+    Stats recompute(const My::CircularBuffer<double>& window) {
+        const auto [first, second] = window.as_spans();
+        Stats s{0.0, 0.0, 0.0, first[0], first[0]};
+        for (std::span<const double> run : {first, second}) {
+            for (double x : run) {
+                s.sum += x;
+                s.min = std::min(s.min, x);
+                s.max = std::max(s.max, x);
+            }
+        }
+        s.mean = s.sum / window.size();
+        double m2 = 0.0;
+        for (std::span<const double> run : {first, second}) {
+            for (double x : run) {
+                m2 += (x - s.mean) * (x - s.mean);
+            }
+        }
+        s.variance = m2 / (window.size() - 1);
+        return s;
+    }
+
+    void bench_recompute(size_t window_size, const std::vector<double>& prices) {
+        My::CircularBuffer<double> window(window_size, My::OverflowPolicy::Overwrite);
+        for (size_t i = 0; i < window_size; ++i) {
+            window.push(prices[i % prices.size()]);
+        }
+        const uint64_t ticks = std::max<uint64_t>(8, g_ticks / std::max<size_t>(window_size / 64, 1));
+
+        const auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < ticks; ++i) {
+            window.push(prices[i % prices.size()]);
+            Bench::do_not_optimize(recompute(window));
+        }
+        const auto end = Bench::Clock::now();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "recompute/window_%zu", window_size);
+        Bench::report(name, Bench::elapsed_ns(start, end) / ticks);
+    }
+
+    void bench_incremental(size_t window_size, const std::vector<double>& prices) {
+        My::RollingWindow<double, My::RollingSum, My::RollingMoments, My::RollingMin, My::RollingMax> window(window_size);
+        for (size_t i = 0; i < window_size; ++i) {
+            window.push(prices[i % prices.size()]);
+        }
+
+        const auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < g_ticks; ++i) {
+            window.push(prices[i % prices.size()]);
+            const auto& moments = window.get<My::RollingMoments>();
+            Bench::do_not_optimize(Stats{window.get<My::RollingSum>().value(), moments.mean(), moments.variance(),
+                                         window.get<My::RollingMin>().value(), window.get<My::RollingMax>().value()});
+        }
+        const auto end = Bench::Clock::now();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "incremental/window_%zu", window_size);
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_ticks);
+    }
+}
+
+int main(int argc, char** argv) {
+    g_ticks = Bench::iterations(argc, argv, g_ticks);
+    const std::vector<double> prices = make_prices(1 << 16);
+
+    std::printf("--- Rolling sum/mean/variance/min/max, ns per tick ---\n");
+    for (size_t window : {size_t(64), size_t(1) << 10, size_t(1) << 14, size_t(1) << 17, size_t(1) << 20}) {
+        bench_recompute(window, prices);
+        bench_incremental(window, prices);
+    }
+    return 0;
+}
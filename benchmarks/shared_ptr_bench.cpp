@@ -0,0 +1,297 @@
+#include "bench_util.h"
+#include "baseline/SharedPtrBaseline.h"
+#include "memory/SharedPtr.h"
+#include "memory/AtomicSharedPtr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Copy/destroy scaling, 1..32 threads.
+
+    * Each thread copies a SharedPtr and drops the copy g_ops times
+    * shared: all threads copy the same object (one contended count);
+    private: one object per thread (the uncontended cost of the protocol)
+    * Baseline::SharedPtr is the header before the memory-order change:
+    seq_cst increment/decrement and virtual dispose. On x86 both are a locked
+    RMW, so the gain there is mostly the cheaper release path; on weaker
+    memory models the relaxed increment saves the barriers as well
+    * make_shared_churn: make_shared + destroy on one thread (allocation,
+    construction, dispose and free through the control block)
+
+    Control-block churn: make_shared + destroy, 1..N threads each on its own
+    objects. Global heap vs pooled_control_block (thread-caching
+    FixedBlockPool) vs allocate_shared on a pmr unsynchronized_pool_resource
+    (one per thread). An order-routing path creates and drops one of these
+    per message
+
+    Thread-confined refcounting, one thread: pass a pointer down a small
+    "graph" (copy into a vector of 8 holders, then drop them), SharedPtr vs
+    LocalSharedPtr. Same block layout, only the count updates differ
+
+    WeakPtr::lock() under contention.
+
+    * T threads each call lock() and drop the result g_ops times
+    * shared: all threads lock the same WeakPtr, so every lock()/release is a
+    CAS/decrement on one contended refCount cache line
+    * private: each thread locks its own object; the uncontended cost of the
+    CAS loop
+    * Reported per lock() (lock + release), wall time divided by total ops
+
+    Snapshot publishing, reader scaling: R readers each take the current
+    snapshot and drop it g_ops times while one writer publishes a new one
+    every kPublishEvery loads' worth of its own loop. AtomicSharedPtr::load()
+    vs copying a SharedPtr under a std::mutex (the writer assigns under the
+    same mutex). Reported per load, wall time divided by total reader ops
+*/
+
+namespace {
+
+    uint64_t g_ops = 2'000'000;
+
+    struct Snapshot {
+        uint64_t version;
+    };
+
+    // Same layout, opted in to the control-block pool
+    struct PooledSnapshot {
+        uint64_t version;
+    };
+
+}
+
+template<>
+struct My::pooled_control_block<PooledSnapshot> : std::true_type {};
+
+namespace {
+
+    // Runs body(thread_index) on threads_count threads started together;
+    // returns the wall time in ns.
+    template<typename Body>
+    double run_threads(unsigned threads_count, Body body) {
+        std::atomic<unsigned> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&, t]() {
+                Bench::pin_thread(t);
+                ready++;
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                body(t);
+            });
+        }
+        while (ready.load() != threads_count) {
+            std::this_thread::yield();
+        }
+
+        const auto start = Bench::Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads) {
+            t.join();
+        }
+        return Bench::elapsed_ns(start, Bench::Clock::now());
+    }
+
+    template<typename Ptr, bool Shared>
+    void copy_destroy(const char* flavour, unsigned threads_count, Ptr (*make)(uint64_t)) {
+        std::vector<Ptr> owners;
+        for (unsigned t = 0; t < (Shared ? 1 : threads_count); ++t) {
+            owners.push_back(make(t));
+        }
+        const double ns = run_threads(threads_count, [&](unsigned t) {
+            const Ptr& source = owners[Shared ? 0 : t];
+            for (uint64_t i = 0; i < g_ops; ++i) {
+                Ptr copy = source;
+                Bench::do_not_optimize(copy.get());
+            }
+        });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "copy/%s/%s/%u_threads", flavour, Shared ? "shared" : "private", threads_count);
+        Bench::report(name, ns / (g_ops * threads_count));
+    }
+
+    My::SharedPtr<Snapshot> make_current(uint64_t v) { return My::make_shared<Snapshot>(Snapshot{v}); }
+    Baseline::SharedPtr<Snapshot> make_baseline(uint64_t v) { return Baseline::make_shared<Snapshot>(Snapshot{v}); }
+
+    template<typename Ptr>
+    void make_shared_churn(const char* name, Ptr (*make)(uint64_t)) {
+        const auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < g_ops; ++i) {
+            Ptr p = make(i);
+            Bench::do_not_optimize(p.get());
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_ops);
+    }
+
+    enum class Source { Heap, Pool, Pmr };
+
+    template<Source From>
+    void block_churn(const char* name, unsigned threads_count) {
+        const double ns = run_threads(threads_count, [](unsigned) {
+            std::pmr::unsynchronized_pool_resource resource;
+            std::pmr::polymorphic_allocator<Snapshot> alloc(&resource);
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < g_ops; ++i) {
+                if constexpr (From == Source::Heap) {
+                    auto p = My::make_shared<Snapshot>(Snapshot{i});
+                    sum += p->version;
+                }
+                else if constexpr (From == Source::Pool) {
+                    auto p = My::make_shared<PooledSnapshot>(PooledSnapshot{i});
+                    sum += p->version;
+                }
+                else {
+                    auto p = My::allocate_shared<Snapshot>(alloc, Snapshot{i});
+                    sum += p->version;
+                }
+            }
+            Bench::do_not_optimize(sum);
+        });
+
+        char full[64];
+        std::snprintf(full, sizeof(full), "%s/%u_threads", name, threads_count);
+        Bench::report(full, ns / (g_ops * threads_count));
+    }
+
+    template<typename Ptr>
+    void confined_copies(const char* name, Ptr (*make)(uint64_t)) {
+        const Ptr root = make(1);
+        std::vector<Ptr> holders(8);
+        const auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < g_ops; ++i) {
+            for (Ptr& h : holders) {
+                h = root;
+            }
+            Bench::do_not_optimize(holders.back().get());
+            for (Ptr& h : holders) {
+                h.reset();
+            }
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / (g_ops * holders.size()));
+    }
+
+    My::LocalSharedPtr<Snapshot> make_local(uint64_t v) { return My::make_local_shared<Snapshot>(Snapshot{v}); }
+
+    template<bool Shared>
+    void lock_contention(unsigned threads_count) {
+        std::vector<My::SharedPtr<Snapshot>> owners;
+        for (unsigned t = 0; t < (Shared ? 1 : threads_count); ++t) {
+            owners.push_back(My::make_shared<Snapshot>(Snapshot{t}));
+        }
+        std::vector<My::WeakPtr<Snapshot>> weaks(owners.begin(), owners.end());
+
+        const double ns = run_threads(threads_count, [&](unsigned t) {
+            const My::WeakPtr<Snapshot>& weak = weaks[Shared ? 0 : t];
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < g_ops; ++i) {
+                sum += weak.lock()->version;
+            }
+            Bench::do_not_optimize(sum);
+        });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "weak_lock/%s/%u_threads", Shared ? "shared" : "private", threads_count);
+        Bench::report(name, ns / (g_ops * threads_count));
+    }
+
+    // Guarded the usual way: one mutex for readers and the writer
+    class MutexSnapshot {
+    public:
+        explicit MutexSnapshot(My::SharedPtr<Snapshot> p): current_(std::move(p)) {}
+        My::SharedPtr<Snapshot> load() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return current_;
+        }
+        void store(My::SharedPtr<Snapshot> p) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            current_ = std::move(p);
+        }
+    private:
+        mutable std::mutex mutex_;
+        My::SharedPtr<Snapshot> current_;
+    };
+
+    template<typename Holder>
+    void reader_scaling(const char* flavour, unsigned readers) {
+        constexpr uint64_t kPublishEvery = 1024;
+        Holder holder(My::make_shared<Snapshot>(Snapshot{0}));
+        std::atomic<unsigned> finished{0};
+
+        //Thread 0 writes, the others read
+        const double ns = run_threads(readers + 1, [&](unsigned t) {
+            if (t == 0) {
+                uint64_t version = 0;
+                while (finished.load(std::memory_order_acquire) != readers) {
+                    for (uint64_t i = 0; i < kPublishEvery; ++i) {
+                        Bench::do_not_optimize(i);
+                    }
+                    holder.store(My::make_shared<Snapshot>(Snapshot{++version}));
+                    std::this_thread::yield();
+                }
+                return;
+            }
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < g_ops; ++i) {
+                sum += holder.load()->version;
+            }
+            Bench::do_not_optimize(sum);
+            finished++;
+        });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "snapshot_load/%s/%u_readers", flavour, readers);
+        Bench::report(name, ns / (g_ops * readers));
+    }
+}
+
+int main(int argc, char** argv) {
+    g_ops = Bench::iterations(argc, argv, g_ops);
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("--- SharedPtr copy + destroy, ns per op (wall / total ops) ---\n");
+    for (unsigned threads = 1; threads <= 32; threads *= 2) {
+        copy_destroy<Baseline::SharedPtr<Snapshot>, true>("baseline", threads, make_baseline);
+        copy_destroy<My::SharedPtr<Snapshot>, true>("current", threads, make_current);
+        copy_destroy<Baseline::SharedPtr<Snapshot>, false>("baseline", threads, make_baseline);
+        copy_destroy<My::SharedPtr<Snapshot>, false>("current", threads, make_current);
+    }
+
+    std::printf("--- make_shared + destroy, one thread ---\n");
+    make_shared_churn("make_shared_churn/baseline", make_baseline);
+    make_shared_churn("make_shared_churn/current", make_current);
+
+    std::printf("--- make_shared + destroy per thread, ns per op (wall / total ops) ---\n");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        block_churn<Source::Heap>("block_churn/global_heap", threads);
+        block_churn<Source::Pool>("block_churn/block_pool", threads);
+        block_churn<Source::Pmr>("block_churn/allocate_shared_pmr", threads);
+    }
+
+    std::printf("--- thread-confined copy + release, ns per copy ---\n");
+    confined_copies("confined/shared_ptr", make_current);
+    confined_copies("confined/local_shared_ptr", make_local);
+
+    std::printf("--- WeakPtr::lock() + release, ns per op (wall / total ops) ---\n");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        lock_contention<true>(threads);
+        lock_contention<false>(threads);
+    }
+
+    std::printf("--- snapshot load + release with one writer, ns per load (wall / total reader ops) ---\n");
+    for (unsigned readers = 1; readers <= max_threads; readers *= 2) {
+        reader_scaling<MutexSnapshot>("mutex_shared_ptr", readers);
+        reader_scaling<My::AtomicSharedPtr<Snapshot>>("atomic_shared_ptr", readers);
+    }
+    return 0;
+}
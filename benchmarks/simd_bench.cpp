@@ -0,0 +1,104 @@
+#include "bench_util.h"
+#include "algorithms/Simd.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/*
+    Scan kernels per build (scalar / sse4.2 / avx2), ns per element.
+
+    * Cases are named like Google Benchmark ones: kernel<type>/build/size
+    * Each case repeats the scan over the same array until about g_elements
+    elements have been read, so small sizes measure the loop from L1 and 1M
+    measures it from memory (8 MB per array)
+    * find_first searches for a value that is not there (a full scan), the
+    worst case of the "first level at or above" query
+    * The scalar build is plain loops at -O2 (BENCH_FLAGS) for the baseline
+    x86-64 ISA; the compiler may vectorise some of them with SSE2, which is the
+    fair comparison for what a build without dispatch would get
+    * dot<int64> has no 64-bit lane multiply before AVX-512, so the vector
+    builds only match scalar there
+*/
+
+namespace {
+
+    uint64_t g_elements = 200'000'000;
+
+    const char* isa_name(My::Isa isa) {
+        switch (isa) {
+            case My::Isa::Avx2: return "avx2";
+            case My::Isa::Sse42: return "sse4.2";
+            default: return "scalar";
+        }
+    }
+
+    template<typename Fn>
+    void run(const char* kernel, const char* type, My::Isa isa, size_t size, Fn&& scan) {
+        const uint64_t reps = std::max<uint64_t>(1, g_elements / size);
+        const auto start = Bench::Clock::now();
+        for (uint64_t r = 0; r < reps; ++r) {
+            Bench::do_not_optimize(scan());
+        }
+        const auto end = Bench::Clock::now();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s<%s>/%s/%zu", kernel, type, isa_name(isa), size);
+        Bench::report(name, Bench::elapsed_ns(start, end) / (double(reps) * size));
+    }
+
+    template<typename T>
+    void bench_type(const char* type, size_t size, const std::vector<My::Isa>& builds) {
+        std::mt19937_64 rng(11);
+        std::uniform_int_distribution<int> dist(-1000, 1000);
+        std::vector<T> a(size);
+        std::vector<T> b(size);
+        for (size_t i = 0; i < size; ++i) {
+            a[i] = T(dist(rng));
+            b[i] = T(dist(rng));
+        }
+        const T absent = T(5000);
+
+        for (My::Isa isa : builds) {
+            const auto& k = My::simd_kernels<T>(isa);
+            run("find_first", type, isa, size, [&] { return k.find_first(a.data(), size, My::Cmp::Ge, absent); });
+        }
+        for (My::Isa isa : builds) {
+            const auto& k = My::simd_kernels<T>(isa);
+            run("count_matching", type, isa, size, [&] { return k.count_matching(a.data(), size, My::Cmp::Gt, T(0)); });
+        }
+        for (My::Isa isa : builds) {
+            const auto& k = My::simd_kernels<T>(isa);
+            run("min_element", type, isa, size, [&] { return k.min_element(a.data(), size).index; });
+        }
+        for (My::Isa isa : builds) {
+            const auto& k = My::simd_kernels<T>(isa);
+            run("sum", type, isa, size, [&] { return k.sum(a.data(), size); });
+        }
+        for (My::Isa isa : builds) {
+            const auto& k = My::simd_kernels<T>(isa);
+            run("dot", type, isa, size, [&] { return k.dot(a.data(), b.data(), size); });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    g_elements = Bench::iterations(argc, argv, g_elements);
+
+    std::vector<My::Isa> builds{My::Isa::Scalar};
+    for (My::Isa isa : {My::Isa::Sse42, My::Isa::Avx2}) {
+        if (My::isa_supported(isa)) {
+            builds.push_back(isa);
+        }
+    }
+    std::printf("Dispatch picks: %s\n", isa_name(My::best_isa()));
+
+    for (size_t size : {size_t(64), size_t(1) << 10, size_t(1) << 14, size_t(1) << 20}) {
+        std::printf("--- %zu elements, ns per element ---\n", size);
+        bench_type<double>("double", size, builds);
+        bench_type<int64_t>("int64", size, builds);
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "bench_util.h"
+#include "baseline/SpscRingBaseline.h"
+#include "queues/SpscRing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+
+/*
+    SpscRing throughput and latency.
+
+    * throughput: producer pushes N messages as fast as it can, consumer drains
+    them; we report wall time per message and cache misses per message
+    * round trip: two rings, one ping and one pong, a single message in flight;
+    half the round trip is the one-way handoff latency
+    * bulk: same as throughput but moving kBatch messages per push_bulk/pop_bulk
+    * push_pop: one thread, push then pop, so the cost is the index arithmetic
+    itself; compares seq % capacity against seq & mask
+    * idle_stream: a quiet feed (one message every kIdleGap). Compares a
+    spinning pop() consumer with pop_wait(): wake-up latency per message and
+    how much CPU the consumer burns while waiting
+    * Baseline::SpscRing is the ring before the cached-index change
+*/
+
+namespace {
+
+    constexpr size_t kRingSize = 4096;
+    constexpr size_t kBatch = 64;
+    constexpr auto kIdleGap = std::chrono::microseconds(50);
+    uint64_t g_messages = 20'000'000;
+    uint64_t g_round_trips = g_messages / 20;
+
+    template<typename Ring>
+    void throughput(const char* name) {
+        Ring ring(kRingSize);
+        Bench::PerfCounter misses;
+
+        misses.start();
+        const auto start = Bench::Clock::now();
+
+        std::thread consumer([&]() {
+            Bench::pin_thread(1);
+            uint64_t val = 0;
+            uint64_t sum = 0;
+            for (uint64_t i = 0; i < g_messages; ++i) {
+                while (!ring.pop(val)) {}
+                sum += val;
+            }
+            Bench::do_not_optimize(sum);
+        });
+
+        Bench::pin_thread(0);
+        for (uint64_t i = 0; i < g_messages; ++i) {
+            while (!ring.push(i)) {}
+        }
+        consumer.join();
+
+        const auto end = Bench::Clock::now();
+        const uint64_t miss_count = misses.stop();
+
+        const double per_msg = Bench::elapsed_ns(start, end) / g_messages;
+        Bench::report(name, per_msg, misses, miss_count, g_messages);
+    }
+
+    template<typename Ring>
+    void bulk_throughput(const char* name) {
+        Ring ring(kRingSize);
+        Bench::PerfCounter misses;
+        const uint64_t total = g_messages - g_messages % kBatch;
+
+        misses.start();
+        const auto start = Bench::Clock::now();
+
+        std::thread consumer([&]() {
+            Bench::pin_thread(1);
+            uint64_t batch[kBatch];
+            uint64_t sum = 0;
+            uint64_t received = 0;
+            while (received < total) {
+                const size_t n = ring.pop_bulk(batch, kBatch);
+                for (size_t i = 0; i < n; ++i) {
+                    sum += batch[i];
+                }
+                received += n;
+            }
+            Bench::do_not_optimize(sum);
+        });
+
+        Bench::pin_thread(0);
+        uint64_t batch[kBatch];
+        for (uint64_t base = 0; base < total; base += kBatch) {
+            for (size_t i = 0; i < kBatch; ++i) {
+                batch[i] = base + i;
+            }
+            size_t sent = 0;
+            while (sent < kBatch) {
+                sent += ring.push_bulk(batch + sent, kBatch - sent);
+            }
+        }
+        consumer.join();
+
+        const auto end = Bench::Clock::now();
+        const uint64_t miss_count = misses.stop();
+
+        const double per_msg = Bench::elapsed_ns(start, end) / total;
+        Bench::report(name, per_msg, misses, miss_count, total);
+    }
+
+    template<typename Ring>
+    void push_pop(const char* name, size_t ring_size) {
+        Ring ring(ring_size);
+        uint64_t val = 0;
+        uint64_t sum = 0;
+
+        const auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < g_messages; ++i) {
+            ring.push(i);
+            ring.pop(val);
+            sum += val;
+        }
+        const auto end = Bench::Clock::now();
+
+        Bench::do_not_optimize(sum);
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_messages);
+    }
+
+    double thread_cpu_ns() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1e9 + ts.tv_nsec;
+    }
+
+    template<bool Blocking>
+    void idle_stream(const char* name) {
+        My::SpscRing<int64_t> ring(kRingSize);
+        const uint64_t messages = g_round_trips / 10 + 1;
+        double latency_ns = 0;
+        double consumer_cpu_ns = 0;
+
+        std::thread consumer([&]() {
+            Bench::pin_thread(1);
+            const double cpu_start = thread_cpu_ns();
+            int64_t sent_at = 0;
+            for (uint64_t i = 0; i < messages; ++i) {
+                if constexpr (Blocking) {
+                    ring.pop_wait(sent_at);
+                }
+                else {
+                    while (!ring.pop(sent_at)) {}
+                }
+                latency_ns += Bench::Clock::now().time_since_epoch().count() - sent_at;
+            }
+            consumer_cpu_ns = thread_cpu_ns() - cpu_start;
+        });
+
+        Bench::pin_thread(0);
+        const auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < messages; ++i) {
+            std::this_thread::sleep_for(kIdleGap);
+            ring.push_wait(Bench::Clock::now().time_since_epoch().count());
+        }
+        consumer.join();
+        const double wall_ns = Bench::elapsed_ns(start, Bench::Clock::now());
+
+        Bench::report(name, latency_ns / messages);
+        std::printf("%-44s %10.1f %% of a core\n", "    consumer cpu while idle", 100.0 * consumer_cpu_ns / wall_ns);
+    }
+
+    template<typename Ring>
+    void round_trip(const char* name) {
+        Ring ping(kRingSize);
+        Ring pong(kRingSize);
+
+        std::thread echo([&]() {
+            Bench::pin_thread(1);
+            uint64_t val = 0;
+            for (uint64_t i = 0; i < g_round_trips; ++i) {
+                while (!ping.pop(val)) {}
+                while (!pong.push(val)) {}
+            }
+        });
+
+        Bench::pin_thread(0);
+        const auto start = Bench::Clock::now();
+        uint64_t val = 0;
+        for (uint64_t i = 0; i < g_round_trips; ++i) {
+            while (!ping.push(i)) {}
+            while (!pong.pop(val)) {}
+        }
+        const auto end = Bench::Clock::now();
+        echo.join();
+
+        // Report the one-way latency (half a round trip)
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_round_trips / 2.0);
+    }
+}
+
+int main(int argc, char** argv) {
+    g_messages = Bench::iterations(argc, argv, g_messages);
+    g_round_trips = g_messages / 20 + 1;
+
+    std::printf("--- SpscRing<uint64_t>, ring size %zu ---\n", kRingSize);
+    using ExactRing = My::SpscRing<uint64_t>;
+    using MaskedRing = My::SpscRing<uint64_t, My::RingCapacity::PowerOfTwo>;
+
+    push_pop<ExactRing>("push_pop/modulo", 1000);
+    push_pop<MaskedRing>("push_pop/mask", 1000);
+
+    throughput<Baseline::SpscRing<uint64_t>>("throughput/baseline");
+    throughput<ExactRing>("throughput/cached_index");
+    throughput<MaskedRing>("throughput/cached_index_mask");
+    bulk_throughput<ExactRing>("throughput/bulk_64");
+    round_trip<Baseline::SpscRing<uint64_t>>("one_way_latency/baseline");
+    round_trip<ExactRing>("one_way_latency/cached_index");
+    round_trip<MaskedRing>("one_way_latency/cached_index_mask");
+
+    idle_stream<false>("idle_stream_latency/spin_pop");
+    idle_stream<true>("idle_stream_latency/pop_wait");
+    return 0;
+}
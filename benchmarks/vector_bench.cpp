@@ -0,0 +1,255 @@
+#include "bench_util.h"
+#include "baseline/VectorBaseline.h"
+#include "memory/SmallVector.h"
+#include "memory/StableVector.h"
+#include "memory/Vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/*
+    Vector growth: push_back N elements into an empty vector, so the cost
+    includes every reallocation on the way.
+
+    * OrderEvent: a 32-byte POD, relocated with one memcpy per growth
+    * unique_ptr: not trivially copyable, relocated by (noexcept) move; shows
+    what the per-element path costs
+    * Baseline::Vector is the vector before the relocation change (2x growth,
+    move-construct + destroy per element)
+
+    Allocation churn: per "tick", build kVectorsPerTick short-lived vectors of
+    a few dozen elements, then drop them all.
+
+    * heap: My::Vector on the global allocator, every block freed one by one
+    * monotonic: My::pmr::Vector on a monotonic_buffer_resource over a fixed
+    buffer; the frees are no-ops and release() resets the arena once per tick
+    * pool: My::pmr::Vector on an unsynchronized_pool_resource (size-class
+    free lists, no locking)
+
+    Bulk append: copy a decoded batch of kBatch events into a vector that is
+    cleared each round (capacity kept). push_back loop vs append(first, last)
+    (one capacity check and one memcpy)
+
+    Small collections: one short-lived collection of 1..8 elements per order
+    (fills, legs, ...). Vector allocates for every one; SmallVector<T, 8>
+    never does
+
+    Growth spikes: the same POD push_back loop, each push timed on its own.
+    Vector's worst push is the last reallocation (copies everything);
+    StableVector's is one chunk allocation. Scan: sum one field over all
+    elements, StableVector chunk by chunk (contiguous inner loop) or through
+    operator[] (shift/mask per element)
+*/
+
+namespace {
+
+    uint64_t g_elements = 10'000'000;
+    uint64_t g_ticks = 100'000;
+    constexpr int kVectorsPerTick = 16;
+
+    struct OrderEvent {
+        uint64_t order_id;
+        int64_t price;
+        uint32_t quantity;
+        uint32_t side;
+        uint64_t timestamp;
+    };
+
+    template<typename Vec>
+    void grow_pod(const char* name) {
+        const auto start = Bench::Clock::now();
+        Vec v;
+        for (uint64_t i = 0; i < g_elements; ++i) {
+            v.push_back(OrderEvent{i, static_cast<int64_t>(i), 1, 0, i});
+        }
+        Bench::do_not_optimize(v.data());
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_elements);
+    }
+
+    template<typename Vec>
+    void grow_unique_ptr(const char* name) {
+        const uint64_t count = g_elements / 10;
+        const auto start = Bench::Clock::now();
+        Vec v;
+        for (uint64_t i = 0; i < count; ++i) {
+            v.push_back(std::make_unique<uint64_t>(i));
+        }
+        Bench::do_not_optimize(v.data());
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / count);
+    }
+
+    // One tick: kVectorsPerTick vectors of 8..56 elements, built then dropped.
+    template<typename MakeVector>
+    void tick(MakeVector make_vector, uint64_t t) {
+        auto v = make_vector();
+        for (int k = 0; k < kVectorsPerTick; ++k) {
+            auto scratch = make_vector();
+            const uint64_t count = 8 + (t + k) % 49;
+            for (uint64_t i = 0; i < count; ++i) {
+                scratch.push_back(OrderEvent{i, static_cast<int64_t>(t), 1, 0, i});
+            }
+            v.push_back(scratch.back());
+        }
+        Bench::do_not_optimize(v.data());
+    }
+
+    void churn_heap() {
+        const auto start = Bench::Clock::now();
+        for (uint64_t t = 0; t < g_ticks; ++t) {
+            tick([]() { return My::Vector<OrderEvent>(); }, t);
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report("churn/heap", Bench::elapsed_ns(start, end) / g_ticks);
+    }
+
+    void churn_monotonic() {
+        static std::byte buffer[1 << 20];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+        const auto start = Bench::Clock::now();
+        for (uint64_t t = 0; t < g_ticks; ++t) {
+            tick([&]() { return My::pmr::Vector<OrderEvent>(&arena); }, t);
+            arena.release();
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report("churn/pmr_monotonic", Bench::elapsed_ns(start, end) / g_ticks);
+    }
+
+    void churn_pool() {
+        std::pmr::unsynchronized_pool_resource pool;
+        const auto start = Bench::Clock::now();
+        for (uint64_t t = 0; t < g_ticks; ++t) {
+            tick([&]() { return My::pmr::Vector<OrderEvent>(&pool); }, t);
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report("churn/pmr_pool", Bench::elapsed_ns(start, end) / g_ticks);
+    }
+
+    constexpr size_t kBatch = 1024;
+
+    template<bool Bulk>
+    void append_batch(const char* name) {
+        std::vector<OrderEvent> batch(kBatch);
+        for (size_t i = 0; i < kBatch; ++i) {
+            batch[i] = OrderEvent{i, static_cast<int64_t>(i), 1, 0, i};
+        }
+        My::Vector<OrderEvent> v;
+        const uint64_t rounds = g_elements / kBatch + 1;
+
+        const auto start = Bench::Clock::now();
+        for (uint64_t r = 0; r < rounds; ++r) {
+            v.clear();
+            if constexpr (Bulk) {
+                v.append(batch.begin(), batch.end());
+            }
+            else {
+                for (const OrderEvent& e : batch) {
+                    v.push_back(e);
+                }
+            }
+            Bench::do_not_optimize(v.data());
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / (rounds * kBatch));
+    }
+
+    template<typename Vec>
+    void grow_worst_case(const char* name) {
+        double worst = 0.0;
+        const auto start = Bench::Clock::now();
+        Vec v;
+        for (uint64_t i = 0; i < g_elements; ++i) {
+            const auto before = Bench::Clock::now();
+            v.push_back(OrderEvent{i, static_cast<int64_t>(i), 1, 0, i});
+            worst = std::max(worst, Bench::elapsed_ns(before, Bench::Clock::now()));
+        }
+        Bench::do_not_optimize(v.back());
+        const auto end = Bench::Clock::now();
+        //Includes two clock reads per push
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_elements);
+        std::printf("%-44s %10.1f us worst push_back\n", "", worst / 1e3);
+    }
+
+    template<int Mode>  // 0: Vector, 1: StableVector chunks, 2: StableVector operator[]
+    void scan(const char* name) {
+        My::Vector<OrderEvent> flat;
+        My::StableVector<OrderEvent> stable;
+        for (uint64_t i = 0; i < g_elements; ++i) {
+            flat.push_back(OrderEvent{i, static_cast<int64_t>(i), 1, 0, i});
+            stable.push_back(OrderEvent{i, static_cast<int64_t>(i), 1, 0, i});
+        }
+        const auto start = Bench::Clock::now();
+        int64_t sum = 0;
+        if constexpr (Mode == 0) {
+            for (const OrderEvent& e : flat) sum += e.price;
+        }
+        else if constexpr (Mode == 1) {
+            for (size_t c = 0; c < stable.chunk_count(); ++c) {
+                for (const OrderEvent& e : stable.chunk(c)) sum += e.price;
+            }
+        }
+        else {
+            for (size_t i = 0; i < stable.size(); ++i) sum += stable[i].price;
+        }
+        Bench::do_not_optimize(sum);
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_elements);
+    }
+
+    template<typename Vec>
+    void small_collections(const char* name) {
+        const auto start = Bench::Clock::now();
+        for (uint64_t order = 0; order < g_elements; ++order) {
+            Vec fills;
+            const uint64_t count = 1 + order % 8;
+            for (uint64_t i = 0; i < count; ++i) {
+                fills.push_back(OrderEvent{order, static_cast<int64_t>(i), 1, 0, i});
+            }
+            Bench::do_not_optimize(fills.back());
+        }
+        const auto end = Bench::Clock::now();
+        Bench::report(name, Bench::elapsed_ns(start, end) / g_elements);
+    }
+}
+
+int main(int argc, char** argv) {
+    g_elements = Bench::iterations(argc, argv, g_elements);
+    g_ticks = g_elements / 100 + 1;
+
+    std::printf("--- push_back from empty, %llu x 32-byte POD ---\n", static_cast<unsigned long long>(g_elements));
+    grow_pod<Baseline::Vector<OrderEvent>>("grow_pod/baseline");
+    grow_pod<My::Vector<OrderEvent, My::GrowDouble>>("grow_pod/memcpy_2x");
+    grow_pod<My::Vector<OrderEvent, My::GrowOneAndHalf>>("grow_pod/memcpy_1.5x");
+
+    std::printf("--- push_back from empty, unique_ptr ---\n");
+    grow_unique_ptr<Baseline::Vector<std::unique_ptr<uint64_t>>>("grow_unique_ptr/baseline");
+    grow_unique_ptr<My::Vector<std::unique_ptr<uint64_t>>>("grow_unique_ptr/move_2x");
+
+    std::printf("--- alloc/free churn, %d short-lived vectors per tick, ns per tick ---\n", kVectorsPerTick);
+    churn_heap();
+    churn_monotonic();
+    churn_pool();
+
+    std::printf("--- copy a %zu-event batch, ns per element ---\n", kBatch);
+    append_batch<false>("append/push_back_loop");
+    append_batch<true>("append/bulk");
+
+    std::printf("--- one 1..8 element collection per order ---\n");
+    small_collections<My::Vector<OrderEvent>>("small_collections/vector");
+    small_collections<My::SmallVector<OrderEvent, 8>>("small_collections/small_vector_8");
+
+    std::printf("--- push_back from empty, per-push latency ---\n");
+    grow_worst_case<My::Vector<OrderEvent>>("grow_latency/vector");
+    grow_worst_case<My::StableVector<OrderEvent>>("grow_latency/stable_vector");
+
+    std::printf("--- sum one field, ns per element ---\n");
+    scan<0>("scan/vector");
+    scan<1>("scan/stable_vector_chunks");
+    scan<2>("scan/stable_vector_index");
+    return 0;
+}
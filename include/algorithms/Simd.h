@@ -0,0 +1,523 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+/*
+   Design thoughts:
+
+   * Linear scans over price ladders: find, count, min/max with index, sum, dot.
+   Each comes in three builds, picked once at runtime from CPUID:
+        - Avx2:   32-byte vectors (4 lanes)
+        - Sse42:  16-byte vectors (2 lanes; SSE4.2 is what has the 64-bit
+        signed compare)
+        - Scalar: plain loops, also the reference the tests compare against
+
+    * One kernel source for both vector widths:
+        - kernels are written once with GCC/Clang vector extensions
+        (T __attribute__((vector_size(Bytes)))), parameterised by the width
+        - they are always_inline, and only ever called from thin entry points
+        marked __attribute__((target("avx2"))) / target("sse4.2"). Inlined
+        there, the same source compiles to AVX2 or SSE instructions, while the
+        rest of the program stays built for the baseline ISA
+        - nothing untargeted may sit in between: the entry points switch on
+        Cmp themselves and call the kernel for each case directly. (A generic
+        lambda, as with_cmp takes, has no target attribute; it only got AVX2
+        code when the optimiser inlined it, so -O0 builds scanned with SSE2)
+        - the entry points for a type form a SimdKernels<T> table of function
+        pointers; simd_kernels<T>() returns the best one for this CPU (chosen
+        on first use), simd_kernels<T>(Isa) a specific one (tests, benchmarks)
+
+    * Element types: int64_t and double (both 8 bytes, so mask and index
+    vectors line up lane for lane with the data)
+
+    * Results match the scalar build exactly, except:
+        - sum/dot of doubles: the vector builds add in a different order (one
+        partial sum per lane), so they can differ in the last bits
+        - min/max assume no NaN
+
+    * Inputs are contiguous ranges: std::span, or anything with data()/size()
+    such as My::Vector and My::Array (wrapped into a span by the overloads)
+
+*/
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MY_SIMD_X86 1
+#else
+#define MY_SIMD_X86 0
+#endif
+
+namespace My {
+
+    enum class Isa { Scalar, Sse42, Avx2 };
+
+    enum class Cmp { Eq, Ne, Lt, Le, Gt, Ge };
+
+    // Position and value of a minimum/maximum. index == size for an empty range.
+    template<typename T>
+    struct IndexedValue {
+        T value;
+        size_t index;
+    };
+
+    template<typename T>
+    struct SimdKernels {
+        Isa isa;
+        size_t (*find_first)(const T* data, size_t size, Cmp cmp, T value);
+        size_t (*count_matching)(const T* data, size_t size, Cmp cmp, T value);
+        IndexedValue<T> (*min_element)(const T* data, size_t size);
+        IndexedValue<T> (*max_element)(const T* data, size_t size);
+        T (*sum)(const T* data, size_t size);
+        T (*dot)(const T* a, const T* b, size_t size);
+    };
+
+    inline bool isa_supported(Isa isa) noexcept {
+#if MY_SIMD_X86
+        __builtin_cpu_init();
+        switch (isa) {
+            case Isa::Avx2:  return __builtin_cpu_supports("avx2");
+            case Isa::Sse42: return __builtin_cpu_supports("sse4.2");
+            case Isa::Scalar: return true;
+        }
+        return false;
+#else
+        return isa == Isa::Scalar;
+#endif
+    }
+
+    inline Isa best_isa() noexcept {
+        if (isa_supported(Isa::Avx2)) return Isa::Avx2;
+        if (isa_supported(Isa::Sse42)) return Isa::Sse42;
+        return Isa::Scalar;
+    }
+
+    namespace simd_detail {
+
+        template<Cmp C, typename T>
+        inline bool matches(T x, T value) noexcept {
+            if constexpr (C == Cmp::Eq) return x == value;
+            else if constexpr (C == Cmp::Ne) return x != value;
+            else if constexpr (C == Cmp::Lt) return x < value;
+            else if constexpr (C == Cmp::Le) return x <= value;
+            else if constexpr (C == Cmp::Gt) return x > value;
+            else return x >= value;
+        }
+
+        // Turns the runtime Cmp into a compile-time one, so no kernel loop
+        // switches per element.
+        template<typename Fn>
+        inline decltype(auto) with_cmp(Cmp cmp, Fn&& fn) {
+            switch (cmp) {
+                case Cmp::Eq: return fn(std::integral_constant<Cmp, Cmp::Eq>{});
+                case Cmp::Ne: return fn(std::integral_constant<Cmp, Cmp::Ne>{});
+                case Cmp::Lt: return fn(std::integral_constant<Cmp, Cmp::Lt>{});
+                case Cmp::Le: return fn(std::integral_constant<Cmp, Cmp::Le>{});
+                case Cmp::Gt: return fn(std::integral_constant<Cmp, Cmp::Gt>{});
+                default:      return fn(std::integral_constant<Cmp, Cmp::Ge>{});
+            }
+        }
+
+        // --- Scalar build (and the tails of the vector builds) ---
+
+        template<typename T>
+        struct Scalar {
+            static size_t find_first(const T* data, size_t size, Cmp cmp, T value) {
+                return with_cmp(cmp, [&](auto c) {
+                    for (size_t i = 0; i < size; i++) {
+                        if (matches<decltype(c)::value>(data[i], value)) return i;
+                    }
+                    return size;
+                });
+            }
+            static size_t count_matching(const T* data, size_t size, Cmp cmp, T value) {
+                return with_cmp(cmp, [&](auto c) {
+                    size_t count = 0;
+                    for (size_t i = 0; i < size; i++) {
+                        count += matches<decltype(c)::value>(data[i], value);
+                    }
+                    return count;
+                });
+            }
+            static IndexedValue<T> min_element(const T* data, size_t size) {
+                IndexedValue<T> best{size ? data[0] : T(), size ? size_t(0) : size};
+                for (size_t i = 1; i < size; i++) {
+                    if (data[i] < best.value) best = {data[i], i};
+                }
+                return best;
+            }
+            static IndexedValue<T> max_element(const T* data, size_t size) {
+                IndexedValue<T> best{size ? data[0] : T(), size ? size_t(0) : size};
+                for (size_t i = 1; i < size; i++) {
+                    if (data[i] > best.value) best = {data[i], i};
+                }
+                return best;
+            }
+            static T sum(const T* data, size_t size) {
+                T total = T();
+                for (size_t i = 0; i < size; i++) total = add(total, data[i]);
+                return total;
+            }
+            static T dot(const T* a, const T* b, size_t size) {
+                T total = T();
+                for (size_t i = 0; i < size; i++) total = add(total, mul(a[i], b[i]));
+                return total;
+            }
+
+            // Integer sums wrap (as unsigned) instead of overflowing
+            static T add(T a, T b) noexcept {
+                if constexpr (std::is_integral_v<T>) return T(std::make_unsigned_t<T>(a) + std::make_unsigned_t<T>(b));
+                else return a + b;
+            }
+            static T mul(T a, T b) noexcept {
+                if constexpr (std::is_integral_v<T>) return T(std::make_unsigned_t<T>(a) * std::make_unsigned_t<T>(b));
+                else return a * b;
+            }
+        };
+
+#if MY_SIMD_X86
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#define MY_SIMD_INLINE inline __attribute__((always_inline))
+
+        //vector_size needs a non-dependent element type (GCC drops the attribute
+        //otherwise), so the vector types are spelled out per width.
+        //Vectors never cross a function boundary by value below (loads go
+        //through a reference, results through out-parameters): passing them
+        //by value from code not built for AVX changes the ABI and warns
+        template<typename E, size_t Bytes>
+        struct VecType;
+#define MY_SIMD_VEC_TYPE(E, Bytes) \
+        template<> struct VecType<E, Bytes> {                                                          \
+            typedef E type __attribute__((vector_size(Bytes)));                                        \
+            typedef E unaligned __attribute__((vector_size(Bytes), aligned(alignof(E)), may_alias));   \
+        };
+        MY_SIMD_VEC_TYPE(int64_t, 16)
+        MY_SIMD_VEC_TYPE(int64_t, 32)
+        MY_SIMD_VEC_TYPE(uint64_t, 16)
+        MY_SIMD_VEC_TYPE(uint64_t, 32)
+        MY_SIMD_VEC_TYPE(double, 16)
+        MY_SIMD_VEC_TYPE(double, 32)
+#undef MY_SIMD_VEC_TYPE
+
+        // --- Vector kernels, one source for every width ---
+
+        template<typename T, size_t Bytes>
+        struct Vec {
+            static_assert(sizeof(T) == 8, "SIMD kernels handle 8-byte elements");
+            static constexpr size_t kLanes = Bytes / sizeof(T);
+            //Integers are added as unsigned so they wrap like Scalar::add
+            using Lane = std::conditional_t<std::is_integral_v<T>, uint64_t, T>;
+            using V = typename VecType<Lane, Bytes>::type;
+            using M = typename VecType<int64_t, Bytes>::type;  // lane masks, also indices
+
+            //Unaligned load of kLanes elements. Copy it into a V before binding
+            //it to a const V& (which would assume full alignment)
+            static MY_SIMD_INLINE const typename VecType<Lane, Bytes>::unaligned& load(const T* p) noexcept {
+                return *reinterpret_cast<const typename VecType<Lane, Bytes>::unaligned*>(p);
+            }
+
+            // Compares as T (signed for integers), not as the unsigned lane type
+            template<Cmp C>
+            static MY_SIMD_INLINE void compare(const V& x, const V& value, M& out) noexcept {
+                if constexpr (std::is_integral_v<T>) {
+                    const M a = (M)x;
+                    const M b = (M)value;
+                    if constexpr (C == Cmp::Eq) out = a == b;
+                    else if constexpr (C == Cmp::Ne) out = a != b;
+                    else if constexpr (C == Cmp::Lt) out = a < b;
+                    else if constexpr (C == Cmp::Le) out = a <= b;
+                    else if constexpr (C == Cmp::Gt) out = a > b;
+                    else out = a >= b;
+                }
+                else {
+                    if constexpr (C == Cmp::Eq) out = x == value;
+                    else if constexpr (C == Cmp::Ne) out = x != value;
+                    else if constexpr (C == Cmp::Lt) out = x < value;
+                    else if constexpr (C == Cmp::Le) out = x <= value;
+                    else if constexpr (C == Cmp::Gt) out = x > value;
+                    else out = x >= value;
+                }
+            }
+
+            static MY_SIMD_INLINE bool any(const M& m) noexcept {
+                int64_t bits = 0;
+                for (size_t i = 0; i < kLanes; i++) bits |= m[i];
+                return bits != 0;
+            }
+
+            template<Cmp C>
+            static MY_SIMD_INLINE size_t find_first(const T* data, size_t size, T value) {
+                const V target = V{} + Lane(value);
+                M hit;
+                size_t i = 0;
+                for (; i + kLanes <= size; i += kLanes) {
+                    const V x = load(data + i);
+                    compare<C>(x, target, hit);
+                    if (any(hit)) {
+                        for (size_t lane = 0; lane < kLanes; lane++) {
+                            if (hit[lane]) return i + lane;
+                        }
+                    }
+                }
+                for (; i < size; i++) {
+                    if (matches<C>(data[i], value)) return i;
+                }
+                return size;
+            }
+
+            template<Cmp C>
+            static MY_SIMD_INLINE size_t count_matching(const T* data, size_t size, T value) {
+                const V target = V{} + Lane(value);
+                M counts = {};
+                M hit;
+                size_t i = 0;
+                for (; i + kLanes <= size; i += kLanes) {
+                    const V x = load(data + i);
+                    compare<C>(x, target, hit);
+                    counts -= hit;  // true lanes are -1
+                }
+                size_t total = 0;
+                for (size_t lane = 0; lane < kLanes; lane++) total += counts[lane];
+                for (; i < size; i++) total += matches<C>(data[i], value);
+                return total;
+            }
+
+            // Each lane keeps its own best (strictly better only, so the
+            // earliest index wins within a lane); lanes are merged at the end.
+            template<bool Min>
+            static MY_SIMD_INLINE IndexedValue<T> extreme(const T* data, size_t size) {
+                if (size < kLanes) {
+                    return Min ? Scalar<T>::min_element(data, size) : Scalar<T>::max_element(data, size);
+                }
+                V best = load(data);
+                M index;
+                M step;
+                for (size_t lane = 0; lane < kLanes; lane++) {
+                    index[lane] = int64_t(lane);
+                    step[lane] = int64_t(kLanes);
+                }
+                M best_index = index;
+                M better;
+
+                size_t i = kLanes;
+                for (; i + kLanes <= size; i += kLanes) {
+                    index += step;
+                    const V x = load(data + i);
+                    if constexpr (Min) compare<Cmp::Lt>(x, best, better);
+                    else compare<Cmp::Gt>(x, best, better);
+                    best = better ? x : best;
+                    best_index = better ? index : best_index;
+                }
+
+                IndexedValue<T> result{T(best[0]), size_t(best_index[0])};
+                for (size_t lane = 1; lane < kLanes; lane++) {
+                    const T v = T(best[lane]);
+                    const size_t at = size_t(best_index[lane]);
+                    const bool wins = Min ? (v < result.value) : (v > result.value);
+                    if (wins || (v == result.value && at < result.index)) result = {v, at};
+                }
+                for (; i < size; i++) {
+                    if (Min ? (data[i] < result.value) : (data[i] > result.value)) result = {data[i], i};
+                }
+                return result;
+            }
+
+            // Four accumulators to hide the add latency.
+            static MY_SIMD_INLINE T sum(const T* data, size_t size) {
+                V acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+                size_t i = 0;
+                for (; i + 4 * kLanes <= size; i += 4 * kLanes) {
+                    acc0 += load(data + i);
+                    acc1 += load(data + i + kLanes);
+                    acc2 += load(data + i + 2 * kLanes);
+                    acc3 += load(data + i + 3 * kLanes);
+                }
+                for (; i + kLanes <= size; i += kLanes) {
+                    acc0 += load(data + i);
+                }
+                const V acc = (acc0 + acc1) + (acc2 + acc3);
+                T total = T();
+                for (size_t lane = 0; lane < kLanes; lane++) total = Scalar<T>::add(total, T(acc[lane]));
+                for (; i < size; i++) total = Scalar<T>::add(total, data[i]);
+                return total;
+            }
+
+            static MY_SIMD_INLINE T dot(const T* a, const T* b, size_t size) {
+                V acc0 = {}, acc1 = {};
+                size_t i = 0;
+                for (; i + 2 * kLanes <= size; i += 2 * kLanes) {
+                    acc0 += load(a + i) * load(b + i);
+                    acc1 += load(a + i + kLanes) * load(b + i + kLanes);
+                }
+                for (; i + kLanes <= size; i += kLanes) {
+                    acc0 += load(a + i) * load(b + i);
+                }
+                const V acc = acc0 + acc1;
+                T total = T();
+                for (size_t lane = 0; lane < kLanes; lane++) total = Scalar<T>::add(total, T(acc[lane]));
+                for (; i < size; i++) total = Scalar<T>::add(total, Scalar<T>::mul(a[i], b[i]));
+                return total;
+            }
+        };
+
+        // --- Entry points: where the kernels get their instruction set ---
+
+        //Runtime Cmp -> K::Kernel<C>, spelled out in the targeted function itself
+#define MY_SIMD_CMP_SWITCH(Kernel)                                                                      \
+                switch (cmp) {                                                                          \
+                    case Cmp::Eq: return K::template Kernel<Cmp::Eq>(data, size, value);                \
+                    case Cmp::Ne: return K::template Kernel<Cmp::Ne>(data, size, value);                \
+                    case Cmp::Lt: return K::template Kernel<Cmp::Lt>(data, size, value);                \
+                    case Cmp::Le: return K::template Kernel<Cmp::Le>(data, size, value);                \
+                    case Cmp::Gt: return K::template Kernel<Cmp::Gt>(data, size, value);                \
+                    default:      return K::template Kernel<Cmp::Ge>(data, size, value);                \
+                }
+
+#define MY_SIMD_ENTRY_POINTS(Name, Target, Bytes)                                                        \
+        template<typename T>                                                                            \
+        struct Name {                                                                                   \
+            using K = Vec<T, Bytes>;                                                                    \
+            __attribute__((target(Target)))                                                             \
+            static size_t find_first(const T* data, size_t size, Cmp cmp, T value) {                    \
+                MY_SIMD_CMP_SWITCH(find_first)                                                          \
+            }                                                                                           \
+            __attribute__((target(Target)))                                                             \
+            static size_t count_matching(const T* data, size_t size, Cmp cmp, T value) {                \
+                MY_SIMD_CMP_SWITCH(count_matching)                                                      \
+            }                                                                                           \
+            __attribute__((target(Target)))                                                             \
+            static IndexedValue<T> min_element(const T* data, size_t size) {                            \
+                return K::template extreme<true>(data, size);                                           \
+            }                                                                                           \
+            __attribute__((target(Target)))                                                             \
+            static IndexedValue<T> max_element(const T* data, size_t size) {                            \
+                return K::template extreme<false>(data, size);                                          \
+            }                                                                                           \
+            __attribute__((target(Target)))                                                             \
+            static T sum(const T* data, size_t size) {                                                  \
+                return K::sum(data, size);                                                              \
+            }                                                                                           \
+            __attribute__((target(Target)))                                                             \
+            static T dot(const T* a, const T* b, size_t size) {                                         \
+                return K::dot(a, b, size);                                                              \
+            }                                                                                           \
+        };
+
+        MY_SIMD_ENTRY_POINTS(Avx2, "avx2", 32)
+        MY_SIMD_ENTRY_POINTS(Sse42, "sse4.2", 16)
+
+#undef MY_SIMD_ENTRY_POINTS
+#undef MY_SIMD_CMP_SWITCH
+#undef MY_SIMD_INLINE
+#pragma GCC diagnostic pop
+#endif
+
+        template<typename T, template<typename> class Build>
+        inline constexpr SimdKernels<T> make_table(Isa isa) {
+            return SimdKernels<T>{isa, &Build<T>::find_first, &Build<T>::count_matching,
+                                  &Build<T>::min_element, &Build<T>::max_element,
+                                  &Build<T>::sum, &Build<T>::dot};
+        }
+    }
+
+    // The kernels of one build. Falls back to Scalar if the CPU lacks it.
+    template<typename T>
+    const SimdKernels<T>& simd_kernels(Isa isa) {
+        static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double>,
+                      "SIMD kernels are provided for int64_t and double");
+        static const SimdKernels<T> scalar = simd_detail::make_table<T, simd_detail::Scalar>(Isa::Scalar);
+#if MY_SIMD_X86
+        static const SimdKernels<T> avx2 = simd_detail::make_table<T, simd_detail::Avx2>(Isa::Avx2);
+        static const SimdKernels<T> sse42 = simd_detail::make_table<T, simd_detail::Sse42>(Isa::Sse42);
+        if (isa == Isa::Avx2 && isa_supported(Isa::Avx2)) return avx2;
+        if (isa == Isa::Sse42 && isa_supported(Isa::Sse42)) return sse42;
+#endif
+        (void)isa;
+        return scalar;
+    }
+
+    // The best build for this CPU, detected once.
+    template<typename T>
+    const SimdKernels<T>& simd_kernels() {
+        static const SimdKernels<T>& best = simd_kernels<T>(best_isa());
+        return best;
+    }
+
+    // --- Algorithms (std::span) ---
+
+    // Index of the first element x with `x cmp value`, or size() if none.
+    // find_first(prices, Cmp::Ge, limit): first level at or above limit.
+    template<typename T>
+    size_t find_first(std::span<const T> data, Cmp cmp, T value) {
+        return simd_kernels<T>().find_first(data.data(), data.size(), cmp, value);
+    }
+
+    // How many elements x satisfy `x cmp value`.
+    template<typename T>
+    size_t count_matching(std::span<const T> data, Cmp cmp, T value) {
+        return simd_kernels<T>().count_matching(data.data(), data.size(), cmp, value);
+    }
+
+    // Smallest / largest element and its (first) index.
+    template<typename T>
+    IndexedValue<T> min_element(std::span<const T> data) {
+        return simd_kernels<T>().min_element(data.data(), data.size());
+    }
+    template<typename T>
+    IndexedValue<T> max_element(std::span<const T> data) {
+        return simd_kernels<T>().max_element(data.data(), data.size());
+    }
+
+    template<typename T>
+    T sum(std::span<const T> data) {
+        return simd_kernels<T>().sum(data.data(), data.size());
+    }
+
+    // Over the common length of a and b.
+    template<typename T>
+    T dot(std::span<const T> a, std::span<const T> b) {
+        return simd_kernels<T>().dot(a.data(), b.data(), std::min(a.size(), b.size()));
+    }
+
+    // --- Algorithms (My::Vector, My::Array, std::vector, ...) ---
+
+    template<typename R>
+    concept SimdRange = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>;
+
+    template<SimdRange R>
+    auto as_const_span(const R& range) {
+        using T = std::remove_cv_t<std::ranges::range_value_t<R>>;
+        return std::span<const T>(std::ranges::data(range), std::ranges::size(range));
+    }
+
+    template<SimdRange R, typename T = std::ranges::range_value_t<R>>
+    size_t find_first(const R& range, Cmp cmp, T value) {
+        return find_first(as_const_span(range), cmp, value);
+    }
+    template<SimdRange R, typename T = std::ranges::range_value_t<R>>
+    size_t count_matching(const R& range, Cmp cmp, T value) {
+        return count_matching(as_const_span(range), cmp, value);
+    }
+    template<SimdRange R>
+    auto min_element(const R& range) {
+        return min_element(as_const_span(range));
+    }
+    template<SimdRange R>
+    auto max_element(const R& range) {
+        return max_element(as_const_span(range));
+    }
+    template<SimdRange R>
+    auto sum(const R& range) {
+        return sum(as_const_span(range));
+    }
+    template<SimdRange A, SimdRange B>
+    auto dot(const A& a, const B& b) {
+        return dot(as_const_span(a), as_const_span(b));
+    }
+}
+
+#undef MY_SIMD_X86
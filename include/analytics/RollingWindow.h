@@ -0,0 +1,225 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include "queues/CircularBuffer.h"
+
+/*
+   Design thoughts:
+
+   * Recomputing sum/mean/variance/min/max over the whole window on every tick
+   is O(window). Each aggregate here is updated in O(1) (amortised for min/max)
+   from just the value that enters and the value that leaves
+
+    * RollingWindow<T, Aggregates...> owns the window (a CircularBuffer in
+    Overwrite mode) and the aggregates, chosen at compile time:
+        RollingWindow<double, RollingSum, RollingMoments, RollingMax> w(1024);
+        w.push(x);
+        w.get<RollingMoments>().variance();
+    An aggregate that is not in the pack is not stored and never updated
+
+    * Aggregate interface (what RollingWindow calls):
+        - Agg(size_t window)
+        - void evict(const T& value, uint64_t seq)   oldest value leaves
+        - void push(const T& value, uint64_t seq)    newest value enters
+    seq numbers the pushes from 0, so an aggregate can tell which element is
+    leaving without storing the window itself
+
+    * Numerics:
+        - RollingSum: Neumaier (improved Kahan) compensation. Adding and later
+        subtracting the same values otherwise leaves rounding residue that
+        grows without bound over a long run
+        - RollingMoments: Welford's update, run backwards on evict. M2 can
+        drift a hair below zero through cancellation, so variance() clamps
+
+    * RollingMin/RollingMax: monotonic deque of (seq, value). A new value
+    discards every queued value it beats, because those can never be the
+    extreme again while it is in the window; the front is the answer. The deque
+    never holds more than `window` entries, so it is a fixed ring
+
+*/
+
+namespace My {
+
+    // Compensated running sum.
+    template<typename T>
+    class RollingSum {
+    public:
+        explicit RollingSum(size_t) {};
+
+        void push(const T& value, uint64_t) noexcept {
+            add(value);
+        };
+        void evict(const T& value, uint64_t) noexcept {
+            add(-value);
+        };
+
+        T value() const noexcept {
+            return sum_ + compensation_;
+        };
+
+    private:
+        // Neumaier: keep the low-order bits lost by whichever operand is smaller
+        void add(T x) noexcept {
+            const T t = sum_ + x;
+            if (std::abs(sum_) >= std::abs(x)) {
+                compensation_ += (sum_ - t) + x;
+            }
+            else {
+                compensation_ += (x - t) + sum_;
+            }
+            sum_ = t;
+        }
+
+        T sum_ = 0;
+        T compensation_ = 0;
+    };
+
+    // Count, mean and variance (Welford).
+    template<typename T>
+    class RollingMoments {
+    public:
+        explicit RollingMoments(size_t) {};
+
+        void push(const T& value, uint64_t) noexcept {
+            count_++;
+            const T delta = value - mean_;
+            mean_ += delta / static_cast<T>(count_);
+            m2_ += delta * (value - mean_);
+        };
+        void evict(const T& value, uint64_t) noexcept {
+            if (--count_ == 0) {
+                mean_ = 0;
+                m2_ = 0;
+                return;
+            }
+            //Welford in reverse
+            const T delta = value - mean_;
+            mean_ -= delta / static_cast<T>(count_);
+            m2_ -= delta * (value - mean_);
+        };
+
+        size_t count() const noexcept {
+            return count_;
+        };
+        T mean() const noexcept {
+            return mean_;
+        };
+        // Sample variance (n - 1); 0 for fewer than two values.
+        T variance() const noexcept {
+            return (count_ < 2) ? T(0) : std::max(m2_, T(0)) / static_cast<T>(count_ - 1);
+        };
+        T population_variance() const noexcept {
+            return (count_ == 0) ? T(0) : std::max(m2_, T(0)) / static_cast<T>(count_);
+        };
+
+    private:
+        size_t count_ = 0;
+        T mean_ = 0;
+        T m2_ = 0;
+    };
+
+    // Window extreme by monotonic deque. Compare(a, b) true = a is "more
+    // extreme" than b (std::less -> minimum).
+    template<typename T, typename Compare>
+    class RollingExtreme {
+    public:
+        explicit RollingExtreme(size_t window):
+            entries_(std::max<size_t>(window, 1))
+        {};
+
+        void push(const T& value, uint64_t seq) {
+            //Drop everything the new value beats (or ties) from the back
+            while (size_ > 0 && !Compare{}(back().value, value)) {
+                size_--;
+            }
+            entries_[slot(size_)] = Entry{seq, value};
+            size_++;
+        };
+        void evict(const T&, uint64_t seq) noexcept {
+            if (size_ > 0 && entries_[head_].seq == seq) {
+                head_ = slot(1);
+                size_--;
+            }
+        };
+
+        // Undefined on an empty window.
+        const T& value() const noexcept {
+            return entries_[head_].value;
+        };
+
+    private:
+        struct Entry {
+            uint64_t seq;
+            T value;
+        };
+
+        size_t slot(size_t offset) const noexcept {
+            const size_t index = head_ + offset;
+            return (index >= entries_.size()) ? index - entries_.size() : index;
+        }
+        const Entry& back() const noexcept {
+            return entries_[slot(size_ - 1)];
+        }
+
+        std::vector<Entry> entries_;
+        size_t head_ = 0;
+        size_t size_ = 0;
+    };
+
+    template<typename T>
+    using RollingMin = RollingExtreme<T, std::less<T>>;
+    template<typename T>
+    using RollingMax = RollingExtreme<T, std::greater<T>>;
+
+    template<typename T, template<typename> class... Aggregates>
+    class RollingWindow {
+    public:
+        explicit RollingWindow(size_t window):
+            window_(window, OverflowPolicy::Overwrite),
+            aggregates_(Aggregates<T>(window)...)
+        {};
+
+        // Adds value; once the window is full the oldest value leaves first.
+        void push(const T& value) {
+            if (window_.capacity() == 0) {
+                return;
+            }
+            if (window_.full()) {
+                const T& oldest = window_.front();
+                const uint64_t oldest_seq = seq_ - window_.size();
+                std::apply([&](auto&... agg) { (agg.evict(oldest, oldest_seq), ...); }, aggregates_);
+            }
+            std::apply([&](auto&... agg) { (agg.push(value, seq_), ...); }, aggregates_);
+            window_.push(value);
+            seq_++;
+        };
+
+        // The aggregate A from the pack, e.g. get<RollingMoments>().
+        template<template<typename> class A>
+        const A<T>& get() const noexcept {
+            return std::get<A<T>>(aggregates_);
+        };
+
+        // The values currently in the window, oldest first.
+        const CircularBuffer<T>& window() const noexcept {
+            return window_;
+        };
+        size_t size() const noexcept {
+            return window_.size();
+        };
+        bool full() const noexcept {
+            return window_.full();
+        };
+
+    private:
+        CircularBuffer<T> window_;
+        std::tuple<Aggregates<T>...> aggregates_;
+        uint64_t seq_ = 0;
+    };
+}
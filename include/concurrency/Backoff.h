@@ -0,0 +1,89 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/*
+   Design thoughts:
+
+   * A waiting thread has three options, from cheapest-to-wake to cheapest-to-run:
+        1. Spin: poll again straight away, with a `pause` between polls so the
+        core does not flood the memory system and its SMT sibling can run
+        2. Yield: give the core to another runnable thread, but stay runnable
+        3. Park: sleep in the kernel until someone notifies us
+
+    * Backoff walks through 1 and 2 with configurable budgets and then tells the
+    caller it is time to park. How to park belongs to the caller (it knows which
+    atomic to wait on and who will notify it)
+
+    * std::atomic::wait has no timed version, so timed waits sleep in growing
+    steps instead of parking once the spin/yield budget is used up
+
+*/
+
+namespace My {
+
+    // Tell the CPU we are in a spin loop.
+    inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // How long to stay on the CPU before parking.
+    struct WaitPolicy {
+        uint32_t spin_count = 256;   // polls separated by cpu_relax()
+        uint32_t yield_count = 16;   // polls separated by std::this_thread::yield()
+    };
+
+    class Backoff {
+    public:
+        explicit Backoff(const WaitPolicy& policy) noexcept:
+            policy_(policy)
+        {};
+
+        // One step of spin -> yield backoff.
+        // Returns false once both budgets are used up: the caller should park.
+        bool pause() noexcept {
+            if (step_ < policy_.spin_count) {
+                cpu_relax();
+            }
+            else if (step_ < policy_.spin_count + policy_.yield_count) {
+                std::this_thread::yield();
+            }
+            else {
+                return false;
+            }
+            step_++;
+            return true;
+        };
+
+        // Used instead of parking by timed waits: sleeps for a growing interval
+        // (capped at the time left). Returns false once the deadline has passed.
+        bool sleep_until(std::chrono::steady_clock::time_point deadline) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(sleep_, deadline - now));
+            sleep_ = std::min<std::chrono::steady_clock::duration>(sleep_ * 2, kMaxSleep);
+            return true;
+        };
+
+    private:
+        static constexpr std::chrono::microseconds kMaxSleep{1000};
+
+        const WaitPolicy policy_;
+        uint32_t step_ = 0;
+        std::chrono::steady_clock::duration sleep_ = std::chrono::microseconds(1);
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*
+   Design thoughts:
+
+   * One writer, any number of readers, readers never block the writer
+        - The writer makes the version odd, writes, makes it even again
+        - A reader copies the value and retries if the version was odd or
+        changed underneath it
+        - So the reader always gets a consistent copy, at the price of copying
+        (T must be trivially copyable) and maybe retrying
+
+    * The payload is stored as relaxed atomic words, not a plain T. A plain T
+    would make the racing copy a data race (UB, and TSan reports it); relaxed
+    word loads/stores are well defined and compile to plain moves
+
+    * Fences (Boehm, "Can seqlocks get along with programming language memory
+    models?"):
+        - writer: odd version, release fence, words, release store of even version
+        - reader: acquire load of version, words, acquire fence, reload version
+
+    * The version also counts writes: after the k-th write it is 2k. Callers
+    use that to tell which write they are looking at
+
+*/
+
+namespace My {
+
+    template<typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "SeqLock: T is copied while it may be written and must be trivially copyable");
+
+    public:
+        SeqLock() noexcept {
+            for (auto& word : words_) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        // Single writer only.
+        void write(const T& value) noexcept {
+            uint64_t buffer[kWords] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+
+            const uint64_t v = version_.load(std::memory_order_relaxed);
+            version_.store(v + 1, std::memory_order_relaxed);
+            //Odd version must be visible before any of the new words
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < kWords; i++) {
+                words_[i].store(buffer[i], std::memory_order_relaxed);
+            }
+            version_.store(v + 2, std::memory_order_release);
+        };
+
+        // Copies a consistent value into out; returns the (even) version it
+        // belongs to. 0 means "never written" (out is then all zero bytes).
+        uint64_t read(T& out) const noexcept {
+            uint64_t buffer[kWords];
+            while (true) {
+                const uint64_t before = version_.load(std::memory_order_acquire);
+                if (before & 1) {
+                    continue;
+                }
+                for (size_t i = 0; i < kWords; i++) {
+                    buffer[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                //Word loads must complete before we re-check the version
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (version_.load(std::memory_order_relaxed) == before) {
+                    std::memcpy(&out, buffer, sizeof(T));
+                    return before;
+                }
+            }
+        };
+
+        // Current version without reading the value (odd while a write is in flight).
+        uint64_t version() const noexcept {
+            return version_.load(std::memory_order_acquire);
+        };
+
+    private:
+        static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        std::atomic<uint64_t> version_{0};
+        std::atomic<uint64_t> words_[kWords];
+    };
+}
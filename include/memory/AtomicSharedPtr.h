@@ -0,0 +1,223 @@
+#pragma once
+#include <cstdint>  // uint64_t, uintptr_t
+#include <cassert>  // assert
+#include <cstdlib>  // std::abort
+#include <atomic>   // std::atomic
+#include <utility>  // std::move
+
+#include "memory/SharedPtr.h"
+
+// Called by a reader just before it tops up the credit (tests stall a reader
+// there).
+#ifndef MY_ATOMIC_SHARED_PTR_TOP_UP_HOOK
+#define MY_ATOMIC_SHARED_PTR_TOP_UP_HOOK() ((void)0)
+#endif
+
+/*
+   Design thoughts:
+
+   * One writer replaces a snapshot now and then, many readers take a
+   SharedPtr to the current one all the time. Copying a plain SharedPtr for
+   that races with the writer reassigning it: the reader can read the control
+   block, the writer drops the last reference, and the reader increments a
+   freed count. A mutex fixes it but readers then queue behind each other and
+   behind the writer
+
+    * Split reference count (as in folly's AtomicSharedPtr):
+        - one 64-bit word holds the control block pointer (low 48 bits) and a
+        "local" count (high 16 bits)
+        - whoever stores a block credits it with kCredit strong references at
+        once. A reader takes one of them with a single fetch_add on the word:
+        the pointer and its reference come out of the same atomic operation,
+        so there is nothing for the writer to race with
+        - the local count says how much credit readers have used. The writer
+        swaps the word out and hands back the credit that was not used
+        (kCredit - local) in one decrement
+        - a reader that sees the local count at kTopUp or above moves kTopUp
+        references from the control block into the credit (count up, local
+        down) before it returns. Several may try at once: the CAS only lowers
+        local while it is still >= kTopUp, and the losers take their
+        increment back. A reader stalled there does not stop the others from
+        topping up, and no thread has more than one load in flight, so local
+        stays below kTopUp + (threads loading). load() aborts rather than take
+        the last credit, which would need kCredit - kTopUp (16k) threads in
+        load() at once
+
+    * Loads are wait-free: one fetch_add and no loop. The exception is the top
+    up (about one load in kTopUp, more while a topping-up reader is stalled),
+    a short CAS loop against other readers (lock-free, never waits for the
+    writer). store/exchange are one exchange;
+    compare_exchange loops only while readers keep changing the local count
+
+    * use_count() (and WeakPtr::use_count()) of a stored object is
+    inflated by the unused credit, about kCredit on top of the real owners.
+    Do not use it to tell whether a published snapshot is still shared
+
+    * compare_exchange compares the stored object (control block), not the
+    word. On failure, expected gets a fresh load(), a separate read after the
+    failed compare: unlike std::atomic<std::shared_ptr>, it is not
+    necessarily the value the compare saw, and may even equal the old
+    expected if the value changed back in between. Retry loops work as usual
+
+    * Needs 64-bit pointers with the top 16 bits unused (x86-64 and AArch64
+    user space with 4-level page tables). Checked on every store, also in
+    release builds: a tagged pointer (LAM, TBI) or a 5-level paging address
+    aborts rather than being silently truncated
+
+*/
+
+namespace My {
+
+    template<typename T>
+    class AtomicSharedPtr {
+        static_assert(sizeof(void*) == 8, "AtomicSharedPtr: needs 64-bit pointers");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+    public:
+        static constexpr bool is_always_lock_free = true;
+
+        // --- Constructors / Destructor ---
+        constexpr AtomicSharedPtr() noexcept = default;
+        AtomicSharedPtr(SharedPtr<T> desired) noexcept:
+            word_(credit(std::move(desired)))
+        {};
+        ~AtomicSharedPtr() {
+            take(word_.load(std::memory_order_acquire));
+        };
+
+        AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+        AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+        // --- Operations ---
+
+        // Wait-free (see above). Never blocks behind store().
+        SharedPtr<T> load() const noexcept {
+            const uint64_t seen = word_.fetch_add(kOneLocal, std::memory_order_acquire);
+            ControlBlock* cb = block(seen);
+            if (cb == nullptr) {
+                return SharedPtr<T>();
+            }
+            //This reference came out of the credit: it is already counted
+            if (local(seen) + 1 >= kTopUp) [[unlikely]] {
+                top_up(cb, local(seen) + 1);
+            }
+            return SharedPtr<T>(static_cast<T*>(cb->object), cb);
+        };
+
+        void store(SharedPtr<T> desired) noexcept {
+            exchange(std::move(desired));
+        };
+
+        SharedPtr<T> exchange(SharedPtr<T> desired) noexcept {
+            const uint64_t old = word_.exchange(credit(std::move(desired)), std::memory_order_acq_rel);
+            return take(old);
+        };
+
+        // Replaces the value with desired if it still holds the same object
+        // as expected; otherwise loads the current value into expected (a
+        // separate load, see the design notes).
+        bool compare_exchange_strong(SharedPtr<T>& expected, SharedPtr<T> desired) noexcept {
+            const uint64_t fresh = credit(std::move(desired));
+            uint64_t word = word_.load(std::memory_order_acquire);
+            while (block(word) == expected.cb_) {
+                //Fails too when only the local count moved: retry
+                if (word_.compare_exchange_weak(word, fresh, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+                    take(word);
+                    return true;
+                }
+            }
+            take(fresh);
+            expected = load();
+            return false;
+        };
+        bool compare_exchange_weak(SharedPtr<T>& expected, SharedPtr<T> desired) noexcept {
+            return compare_exchange_strong(expected, std::move(desired));
+        };
+
+        bool is_lock_free() const noexcept { return true; };
+
+        operator SharedPtr<T>() const noexcept { return load(); };
+        AtomicSharedPtr& operator=(SharedPtr<T> desired) noexcept {
+            store(std::move(desired));
+            return *this;
+        };
+
+    private:
+        static constexpr unsigned kLocalShift = 48;
+        static constexpr uint64_t kOneLocal = uint64_t(1) << kLocalShift;
+        static constexpr uint64_t kPointerMask = kOneLocal - 1;
+        static constexpr long kCredit = long(1) << 15;
+        static constexpr long kTopUp = long(1) << 14;
+
+        static ControlBlock* block(uint64_t word) noexcept {
+            return reinterpret_cast<ControlBlock*>(word & kPointerMask);
+        }
+        static long local(uint64_t word) noexcept {
+            return long(word >> kLocalShift);
+        }
+
+        // desired's reference plus kCredit - 1 more, packed with local = 0.
+        static uint64_t credit(SharedPtr<T> desired) noexcept {
+            ControlBlock* cb = std::exchange(desired.cb_, nullptr);
+            desired.ptr_ = nullptr;
+            if (cb != nullptr) {
+                cb->refCount.fetch_add(kCredit - 1, std::memory_order_relaxed);
+            }
+            const uint64_t word = reinterpret_cast<uintptr_t>(cb);
+            //Always checked: a release build would otherwise corrupt the packed word
+            if ((word & ~kPointerMask) != 0) [[unlikely]] {
+                assert(false && "AtomicSharedPtr: pointer uses the top 16 bits");
+                std::abort();
+            }
+            return word;
+        }
+
+        // A word that is no longer published -> SharedPtr with one reference;
+        // the unused credit goes back to the block.
+        static SharedPtr<T> take(uint64_t word) noexcept {
+            ControlBlock* cb = block(word);
+            if (cb == nullptr) {
+                return SharedPtr<T>();
+            }
+            const long unused = kCredit - local(word);
+            //The reference handed out here is the atomic's own. load() never
+            //takes the last credit, so there is one left
+            assert(unused >= 1 && "AtomicSharedPtr: credit over-drawn");
+            if (unused < 1) {
+                std::abort();
+            }
+            if (unused > 1) {
+                cb->release_strong(unused - 1);
+            }
+            return SharedPtr<T>(static_cast<T*>(cb->object), cb);
+        }
+
+        // Turns kTopUp used credit back into fresh credit (used: the local
+        // count including the caller's load). The caller holds a reference,
+        // so undoing the increment can never reach 0.
+        void top_up(ControlBlock* cb, long used) const noexcept {
+            if (used >= kCredit) {
+                //Reference not counted: unreachable below 16k loading threads
+                assert(false && "AtomicSharedPtr: credit over-drawn");
+                std::abort();
+            }
+            MY_ATOMIC_SHARED_PTR_TOP_UP_HOOK();
+            cb->refCount.fetch_add(kTopUp, std::memory_order_relaxed);
+            uint64_t word = word_.load(std::memory_order_relaxed);
+            while (block(word) == cb && local(word) >= kTopUp) {
+                //Release: a writer that swaps out the lowered word also sees
+                //the increment, so it cannot give those references back first
+                if (word_.compare_exchange_weak(word, word - kTopUp * kOneLocal, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+            //Replaced meanwhile: the writer already settled the credit
+            cb->release_strong(kTopUp);
+        }
+
+        mutable std::atomic<uint64_t> word_{0};
+    };
+
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>          // size_t
+#include <new>              // aligned operator new
+#include <mutex>            // std::mutex, std::lock_guard
+#include <algorithm>        // std::max
+
+/*
+   Design thoughts:
+
+   * FixedBlockPool<Size, Align>: blocks of one size, for objects allocated
+   and freed at a high rate (control blocks: one per SharedPtr(T*) or
+   make_shared). A malloc call is replaced by popping a free list
+
+    * Thread caching (tcmalloc-style):
+        - each thread keeps its own free list; allocate/deallocate touch only
+        that list, no lock and no atomic
+        - the cache refills from a shared list, kBatch blocks per lock; when
+        it holds more than kCacheLimit it gives kBatch back. A block freed on
+        another thread than the one that allocated it just joins the freeing
+        thread's cache
+        - a thread's cache goes back to the shared list when the thread exits.
+        Blocks freed or allocated on that thread after that (a thread_local
+        or static SharedPtr destroyed after the cache) go straight to the
+        shared list under the lock
+        - the shared list grows by slabs of kSlab blocks from operator new
+
+    * Memory goes back to the pool, never to the system: the pool keeps the
+    peak number of blocks for the life of the process. The pool object itself
+    is never destroyed either, so a thread exiting during static destruction
+    can still hand its cache back
+
+*/
+
+namespace My {
+
+template <size_t Size, size_t Align = alignof(std::max_align_t)>
+class FixedBlockPool {
+public:
+    static constexpr size_t kCacheLimit = 256;
+    static constexpr size_t kBatch = 64;
+    static constexpr size_t kSlab = 128;
+
+    // Block size: room for the free-list link, rounded up to the alignment.
+    static constexpr size_t kAlign = std::max(Align, alignof(void*));
+    static constexpr size_t kBlockSize = (std::max(Size, sizeof(void*)) + kAlign - 1) / kAlign * kAlign;
+
+    static FixedBlockPool& instance() {
+        //Leaked on purpose (see above)
+        static FixedBlockPool* pool = new FixedBlockPool();
+        return *pool;
+    }
+
+    void* allocate() {
+        if (cache_gone()) [[unlikely]] {
+            return allocate_shared_list();
+        }
+        Cache& cache = local_cache();
+        if (cache.head == nullptr) {
+            refill(cache);
+        }
+        Node* node = cache.head;
+        cache.head = node->next;
+        cache.count--;
+        return node;
+    }
+
+    void deallocate(void* block) noexcept {
+        Node* node = static_cast<Node*>(block);
+        if (cache_gone()) [[unlikely]] {
+            return deallocate_shared_list(node);
+        }
+        Cache& cache = local_cache();
+        node->next = cache.head;
+        cache.head = node;
+        if (++cache.count > kCacheLimit) {
+            give_back(cache, kBatch);
+        }
+    }
+
+    // Blocks in the calling thread's cache (tests, tuning).
+    size_t cached() const noexcept {
+        return cache_gone() ? 0 : local_cache().count;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    struct Cache {
+        Node* head = nullptr;
+        size_t count = 0;
+
+        ~Cache() {
+            cache_gone() = true;
+            instance().give_back(*this, count);
+        }
+    };
+
+    FixedBlockPool() = default;
+
+    static Cache& local_cache() noexcept {
+        thread_local Cache cache;
+        return cache;
+    }
+
+    // Set once this thread's Cache is destroyed. A bool, so it stays valid
+    // for the rest of the thread (no destructor to run).
+    static bool& cache_gone() noexcept {
+        thread_local bool gone = false;
+        return gone;
+    }
+
+    void* allocate_shared_list() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_ == nullptr) {
+            add_slab();
+        }
+        Node* node = free_;
+        free_ = node->next;
+        return node;
+    }
+
+    void deallocate_shared_list(Node* node) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        node->next = free_;
+        free_ = node;
+    }
+
+    // Moves up to kBatch blocks from the shared list (or a new slab) into cache.
+    void refill(Cache& cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_ == nullptr) {
+            add_slab();
+        }
+        for (size_t i = 0; i < kBatch && free_ != nullptr; i++) {
+            Node* node = free_;
+            free_ = node->next;
+            node->next = cache.head;
+            cache.head = node;
+            cache.count++;
+        }
+    }
+
+    // Moves count blocks from the front of cache to the shared list.
+    void give_back(Cache& cache, size_t count) noexcept {
+        if (count == 0) return;
+        Node* first = cache.head;
+        Node* last = first;
+        for (size_t i = 1; i < count; i++) {
+            last = last->next;
+        }
+        cache.head = last->next;
+        cache.count -= count;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        last->next = free_;
+        free_ = first;
+    }
+
+    //Called with mutex_ held
+    void add_slab() {
+        auto* slab = static_cast<std::byte*>(::operator new(kBlockSize * kSlab, std::align_val_t{kAlign}));
+        for (size_t i = kSlab; i > 0; i--) {
+            Node* node = reinterpret_cast<Node*>(slab + (i - 1) * kBlockSize);
+            node->next = free_;
+            free_ = node;
+        }
+    }
+
+    std::mutex mutex_;
+    Node* free_ = nullptr;
+};
+
+} // namespace My
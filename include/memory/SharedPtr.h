@@ -2,83 +2,373 @@
 #include <cstddef>  // std::nullptr_t
 #include <utility>  // std::forward, std::move
 #include <atomic>   // std::atomic
+#include <new>      // placement new
+#include <type_traits> // std::is_same_v
+#include <memory>   // std::allocator_traits
+
+#include "memory/BlockPool.h"
+
+/*
+   Design thoughts:
+
+   * Two counts per control block:
+        - refCount: SharedPtr owners. When it hits 0 the object is destroyed
+        (dispose)
+        - weakCount: WeakPtr owners, +1 held by all the SharedPtr owners
+        together. When it hits 0 the control block itself is freed (destroy)
+   So a WeakPtr keeps the block alive (to read the count) but not the object
+
+    * WeakPtr::lock() must never bring a dead object back: it takes a strong
+    reference with a CAS loop that only ever goes from n > 0 to n + 1. A plain
+    increment could turn 0 into 1 after the last owner already started
+    destroying the object
+
+    * make_shared: one allocation for block + object (AllocationBlock). The
+    object sits in a union so dispose can end its lifetime at refCount 0,
+    while the storage stays until the last WeakPtr is gone
+
+    * Memory order of the counts (the usual protocol):
+        - increment: relaxed. The new owner is copied from a live one, so the
+        count cannot be 0 and nobody is waiting on the increment
+        - decrement: release, and an acquire fence for the one that hits 0.
+        Every owner's last writes to the object happen before the destructor
+        - lock(): the CAS is acq_rel on success (it creates an owner out of
+        thin air, so it must see the object as the last owner left it)
+
+    * Count policy (BasicSharedPtr<T, CountPolicy>):
+        - AtomicCount: the protocol above. SharedPtr<T> / WeakPtr<T>
+        - LocalCount: plain load + store, no locked instruction. For object
+        graphs that never leave one thread: LocalSharedPtr<T> /
+        LocalWeakPtr<T>, make_local_shared
+        - both use the same blocks (make_local_shared is one allocation too).
+        A local block carries a flag; the explicit LocalSharedPtr -> SharedPtr
+        conversion clears it, after which the local owners count atomically
+        as well (one predictable branch on their path)
+
+    * Where the block comes from:
+        - default: global new/delete
+        - allocate_shared<T>(alloc, args...): one allocation from alloc
+        (AllocatorBlock keeps a copy of it to give the memory back)
+        - pooled_control_block<T> opt-in: SharedPtr<T>(new T) and
+        make_shared<T> take their blocks from a thread-caching FixedBlockPool
+        (BlockPool.h), no malloc on the hot path
+
+    * No vtable: the block stores two plain function pointers, dispose and
+    destroy, filled in by the concrete block's constructor. Releasing is one
+    load and an indirect call instead of vptr -> vtable -> call, and the
+    block needs no virtual destructor
+
+*/
+
+//GCC defines __SANITIZE_THREAD__ under -fsanitize=thread, Clang only
+//answers __has_feature(thread_sanitizer)
+#if defined(__SANITIZE_THREAD__)
+#define MY_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MY_TSAN 1
+#endif
+#endif
+#ifndef MY_TSAN
+#define MY_TSAN 0
+#endif
 
 namespace My {
 
-    // --- Forward Declaration of Control Block ---
-    // You must implement the Control Block hierarchy in your private/implementation section.
-    // It is not exposed to the user.
+    // --- Control Block ---
+    // Not exposed to the user.
     struct ControlBlock {
+        using Hook = void (*)(ControlBlock*) noexcept;
+
         std::atomic<long> refCount = 1;
+        std::atomic<long> weakCount = 1;
+        //Destroys the managed object (refCount hit 0)
+        const Hook dispose;
+        //Frees the control block (weakCount hit 0)
+        const Hook destroy;
+        //The managed object (what get() returns). AtomicSharedPtr stores
+        //only the block, and gets the object back from here
+        void* object = nullptr;
+        //Counted with plain loads/stores (LocalCount). Only the one thread
+        //that owns a local block ever reads or writes this
+        bool local = false;
+
+        ControlBlock(Hook dispose_hook, Hook destroy_hook) noexcept:
+            dispose(dispose_hook), destroy(destroy_hook)
+        {};
+
+        //A new owner is always made from an existing one, which keeps the
+        //count above 0: nothing to order
+        void add_strong() noexcept {
+            refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        void add_weak() noexcept {
+            weakCount.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        //Universal button
-        virtual void dispose() = 0;
+        // Drops count references at once (AtomicSharedPtr hands back its
+        // unused credit this way).
+        void release_strong(long count = 1) noexcept {
+            if (release_count(refCount, count)) {
+                dispose(this);
+                release_weak();
+            }
+        }
+        void release_weak() noexcept {
+            if (release_count(weakCount, 1)) {
+                destroy(this);
+            }
+        }
 
-        //Virtual destructor
-        virtual ~ControlBlock() = default;
+        // refCount + 1 unless it is already 0 (object gone).
+        bool try_acquire_strong() noexcept {
+            long count = refCount.load(std::memory_order_relaxed);
+            while (count != 0) {
+                if (refCount.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        long use_count() const noexcept {
+            return refCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Decrement; true for the last owner, which then sees every write the
+        // other owners made before their release.
+        static bool release_count(std::atomic<long>& count, long n) noexcept {
+#if MY_TSAN
+            //TSan does not model standalone fences: same guarantee, one RMW
+            return count.fetch_sub(n, std::memory_order_acq_rel) == n;
+#else
+            if (count.fetch_sub(n, std::memory_order_release) == n) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return true;
+            }
+            return false;
+#endif
+        }
     };
 
+    // --- Control Block Allocation ---
+
+    // Opt-in trait: specialise to std::true_type to take the control blocks
+    // of SharedPtr<T>(new T) and make_shared<T> from a thread-caching
+    // FixedBlockPool instead of the global heap.
+    template<typename T>
+    struct pooled_control_block : std::false_type {};
+
     template<typename T>
-    struct DefaultControlBlock : ControlBlock {
-        T* managed_ptr_;
+    inline constexpr bool pooled_control_block_v = pooled_control_block<T>::value;
+
+    //Global new/delete, unless pooled
+    template<typename Block, bool Pooled>
+    struct BlockAllocation {};
+
+    template<typename Block>
+    struct BlockAllocation<Block, true> {
+        static void* operator new(size_t) {
+            return pool().allocate();
+        };
+        static void operator delete(void* block) noexcept {
+            pool().deallocate(block);
+        };
+
+    private:
+        //Block is still incomplete where this base is instantiated
+        static auto& pool() {
+            return FixedBlockPool<sizeof(Block), alignof(Block)>::instance();
+        }
+    };
 
-        DefaultControlBlock(T* ptr) : managed_ptr_(ptr) {};
+    template<typename T>
+    struct DefaultControlBlock : ControlBlock, BlockAllocation<DefaultControlBlock<T>, pooled_control_block_v<T>> {
+        DefaultControlBlock(T* ptr) : ControlBlock(&dispose_hook, &destroy_hook) {
+            object = ptr;
+        };
 
-        void dispose() override {
-            delete managed_ptr_;
-            delete this;
+        static void dispose_hook(ControlBlock* cb) noexcept {
+            delete static_cast<T*>(cb->object);
+        };
+        static void destroy_hook(ControlBlock* cb) noexcept {
+            delete static_cast<DefaultControlBlock*>(cb);
         };
     };
 
     template<typename T>
-    struct AllocationBlock : ControlBlock {
-        T object;
+    struct AllocationBlock : ControlBlock, BlockAllocation<AllocationBlock<T>, pooled_control_block_v<T>> {
+        //In a union so that dispose can destroy it before the block is freed
+        union {
+            T object;
+        };
 
         template<typename... Args>
-        AllocationBlock(Args&&... args):
-            object(std::forward<Args>(args)...)
-        {};
+        AllocationBlock(Args&&... args): ControlBlock(&dispose_hook, &destroy_hook) {
+            new (&object) T(std::forward<Args>(args)...);
+            ControlBlock::object = &object;
+        };
+        ~AllocationBlock() {};
 
-        void dispose() override {
-            delete this;
-        }
+        static void dispose_hook(ControlBlock* cb) noexcept {
+            static_cast<AllocationBlock*>(cb)->object.~T();
+        };
+        static void destroy_hook(ControlBlock* cb) noexcept {
+            delete static_cast<AllocationBlock*>(cb);
+        };
     };
 
+    // allocate_shared: block + object in one allocation from Alloc, handed
+    // back to (a copy of) the same allocator when the last WeakPtr goes.
+    template<typename T, typename Alloc>
+    struct AllocatorBlock : ControlBlock {
+        using Traits = std::allocator_traits<Alloc>;
+        using BlockAlloc = typename Traits::template rebind_alloc<AllocatorBlock>;
+        using ObjectAlloc = typename Traits::template rebind_alloc<T>;
+
+        [[no_unique_address]] BlockAlloc alloc_;
+        union {
+            T object;
+        };
 
+        template<typename... Args>
+        AllocatorBlock(const Alloc& alloc, Args&&... args):
+            ControlBlock(&dispose_hook, &destroy_hook), alloc_(alloc)
+        {
+            //Through the allocator, so a pmr allocator reaches pmr members of T
+            ObjectAlloc object_alloc(alloc_);
+            std::allocator_traits<ObjectAlloc>::construct(object_alloc, &object, std::forward<Args>(args)...);
+            ControlBlock::object = &object;
+        };
+        ~AllocatorBlock() {};
+
+        static void dispose_hook(ControlBlock* cb) noexcept {
+            auto* self = static_cast<AllocatorBlock*>(cb);
+            ObjectAlloc object_alloc(self->alloc_);
+            std::allocator_traits<ObjectAlloc>::destroy(object_alloc, &self->object);
+        };
+        static void destroy_hook(ControlBlock* cb) noexcept {
+            auto* self = static_cast<AllocatorBlock*>(cb);
+            BlockAlloc alloc(std::move(self->alloc_));
+            self->~AllocatorBlock();
+            std::allocator_traits<BlockAlloc>::deallocate(alloc, self, 1);
+        };
+    };
+
+    // --- Count Policies ---
+
+    // Thread-safe counts (the protocol above). SharedPtr / WeakPtr.
+    struct AtomicCount {
+        static void adopt(ControlBlock*) noexcept {};
+        static void add_strong(ControlBlock* cb) noexcept { cb->add_strong(); };
+        static void add_weak(ControlBlock* cb) noexcept { cb->add_weak(); };
+        static void release_strong(ControlBlock* cb) noexcept { cb->release_strong(); };
+        static void release_weak(ControlBlock* cb) noexcept { cb->release_weak(); };
+        static bool try_acquire_strong(ControlBlock* cb) noexcept { return cb->try_acquire_strong(); };
+    };
+
+    // Single-thread counts: relaxed load + store, no locked RMW.
+    // LocalSharedPtr / LocalWeakPtr, for objects that never leave their thread.
+    // Once a block has been converted to a SharedPtr (local == false) every
+    // count update on it goes atomic again, including the local owners' ones.
+    struct LocalCount {
+        static void adopt(ControlBlock* cb) noexcept {
+            cb->local = true;
+        };
+        static void add_strong(ControlBlock* cb) noexcept {
+            if (!cb->local) return cb->add_strong();
+            bump(cb->refCount, 1);
+        };
+        static void add_weak(ControlBlock* cb) noexcept {
+            if (!cb->local) return cb->add_weak();
+            bump(cb->weakCount, 1);
+        };
+        static void release_strong(ControlBlock* cb) noexcept {
+            if (!cb->local) return cb->release_strong();
+            if (bump(cb->refCount, -1) == 0) {
+                cb->dispose(cb);
+                release_weak(cb);
+            }
+        };
+        static void release_weak(ControlBlock* cb) noexcept {
+            if (!cb->local) return cb->release_weak();
+            if (bump(cb->weakCount, -1) == 0) {
+                cb->destroy(cb);
+            }
+        };
+        static bool try_acquire_strong(ControlBlock* cb) noexcept {
+            if (!cb->local) return cb->try_acquire_strong();
+            if (cb->refCount.load(std::memory_order_relaxed) == 0) {
+                return false;
+            }
+            bump(cb->refCount, 1);
+            return true;
+        };
+
+    private:
+        static long bump(std::atomic<long>& count, long delta) noexcept {
+            const long value = count.load(std::memory_order_relaxed) + delta;
+            count.store(value, std::memory_order_relaxed);
+            return value;
+        }
+    };
+
+    template<typename T, typename CountPolicy>
+    class BasicWeakPtr;
 
     template<typename T>
-    class SharedPtr {
+    class AtomicSharedPtr;
+
+    template<typename T, typename CountPolicy = AtomicCount>
+    class BasicSharedPtr {
     public:
         // --- Constructors ---
 
         // Default Constructor (Null)
-        constexpr SharedPtr() noexcept {
+        constexpr BasicSharedPtr() noexcept {
             cb_ = nullptr;
             ptr_ = nullptr;
         };
-        constexpr SharedPtr(std::nullptr_t) noexcept;
+        constexpr BasicSharedPtr(std::nullptr_t) noexcept;
 
         // Constructor from raw pointer
         // Requirement: Allocates a Control Block.
-        explicit SharedPtr(T* ptr) {
+        explicit BasicSharedPtr(T* ptr) {
             cb_ = new My::DefaultControlBlock<T>(ptr);
+            CountPolicy::adopt(cb_);
             ptr_ = ptr;
         };
 
+        // LocalSharedPtr -> SharedPtr (explicit: the object may now cross threads).
+        // Switches the whole block to atomic counting, the local owners
+        // included, so it is safe to hand the result to another thread.
+        explicit BasicSharedPtr(const BasicSharedPtr<T, LocalCount>& local) noexcept
+            requires std::is_same_v<CountPolicy, AtomicCount>
+        {
+            ptr_ = local.ptr_;
+            cb_ = local.cb_;
+            if (cb_) {
+                cb_->local = false;
+                CountPolicy::add_strong(cb_);
+            }
+        };
+
 
         // Copy Constructor
         // Requirement: Increments ref_count.
-        SharedPtr(const SharedPtr& other) noexcept {
+        BasicSharedPtr(const BasicSharedPtr& other) noexcept {
             ptr_ = other.ptr_;
             cb_ = other.cb_;
             if (cb_) {
-                cb_->refCount++;
+                CountPolicy::add_strong(cb_);
             }
         };
 
         // Move Constructor
         // Requirement: Steals ownership. Ref_count remains unchanged.
-        SharedPtr(SharedPtr&& other) noexcept {
+        BasicSharedPtr(BasicSharedPtr&& other) noexcept {
             cb_ = other.cb_;
             ptr_ = other.ptr_;
 
@@ -88,16 +378,16 @@ namespace My {
 
         // --- Destructor ---
         // Requirement: Decrements ref_count. If 0, destroys object AND Control Block.
-        ~SharedPtr() {
+        ~BasicSharedPtr() {
             release_ownership();
         };
 
         // --- Assignment Operators ---
 
         // Copy Assignment
-        SharedPtr& operator=(const SharedPtr& other) noexcept {
+        BasicSharedPtr& operator=(const BasicSharedPtr& other) noexcept {
             if (other.cb_) {
-                other.cb_->refCount++;
+                CountPolicy::add_strong(other.cb_);
             }
 
             release_ownership();
@@ -109,7 +399,7 @@ namespace My {
         };
 
         // Move Assignment
-        SharedPtr& operator=(SharedPtr&& other) noexcept {
+        BasicSharedPtr& operator=(BasicSharedPtr&& other) noexcept {
             if (this == &other) {
                 return *this;
             }
@@ -143,6 +433,7 @@ namespace My {
             DefaultControlBlock<T>* temp_cb = nullptr;
             if (ptr) {
                 temp_cb = new DefaultControlBlock<T>(ptr);
+                CountPolicy::adopt(temp_cb);
             }
 
             release_ownership();
@@ -165,7 +456,7 @@ namespace My {
 
         // Returns the current number of owners.
         long use_count() const noexcept {
-            return (cb_ != nullptr) ? cb_->refCount.load() : 0;
+            return (cb_ != nullptr) ? cb_->use_count() : 0;
         };
 
         explicit operator bool() const noexcept {
@@ -175,20 +466,26 @@ namespace My {
     private:
         // Constructor from raw pointer and cb
         // This is dangerous to allow a user to use it
-        explicit SharedPtr(T* ptr, ControlBlock* cb) {
+        explicit BasicSharedPtr(T* ptr, ControlBlock* cb) {
             ptr_ = ptr;
             cb_ = cb;
         };
 
         // Hint: You need access to the control block for make_shared logic
-        template<typename U, typename... Args>
-        friend SharedPtr<U> make_shared(Args&&... args);
+        template<typename U, typename Policy, typename... Args>
+        friend BasicSharedPtr<U, Policy> make_basic_shared(Args&&... args);
+        template<typename U, typename Policy, typename Alloc, typename... Args>
+        friend BasicSharedPtr<U, Policy> allocate_basic_shared(const Alloc& alloc, Args&&... args);
+
+        template<typename U, typename Policy>
+        friend class BasicSharedPtr;
+        friend class BasicWeakPtr<T, CountPolicy>;
+        template<typename U>
+        friend class AtomicSharedPtr;
 
         void release_ownership() noexcept {
             if (cb_) {
-                if (cb_->refCount.fetch_sub(1) == 1) {
-                    cb_->dispose();
-                }
+                CountPolicy::release_strong(cb_);
             }
         };
 
@@ -196,15 +493,140 @@ namespace My {
         T* ptr_= nullptr;
     };
 
-    // --- Factory Function ---
+    template<typename T>
+    using SharedPtr = BasicSharedPtr<T, AtomicCount>;
+    template<typename T>
+    using LocalSharedPtr = BasicSharedPtr<T, LocalCount>;
+
+    // --- Factory Functions ---
     // Requirement: Performs ONE memory allocation for both the Object and the Control Block.
+    // Same block layout for both flavours.
+    template<typename T, typename CountPolicy, typename... Args>
+    BasicSharedPtr<T, CountPolicy> make_basic_shared(Args&&... args) {
+
+        AllocationBlock<T>* ac = new AllocationBlock<T>(std::forward<Args>(args)...);
+        CountPolicy::adopt(ac);
+
+        return BasicSharedPtr<T, CountPolicy>(&ac->object, ac);
+    };
+
     template<typename T, typename... Args>
     SharedPtr<T> make_shared(Args&&... args) {
+        return make_basic_shared<T, AtomicCount>(std::forward<Args>(args)...);
+    };
 
-        AllocationBlock<T>* ac = new AllocationBlock<T>(std::forward<Args>(args)...);
+    template<typename T, typename... Args>
+    LocalSharedPtr<T> make_local_shared(Args&&... args) {
+        return make_basic_shared<T, LocalCount>(std::forward<Args>(args)...);
+    };
 
-        return SharedPtr(&ac->object, ac);
+    // Like make_shared, with the single allocation taken from alloc.
+    template<typename T, typename CountPolicy, typename Alloc, typename... Args>
+    BasicSharedPtr<T, CountPolicy> allocate_basic_shared(const Alloc& alloc, Args&&... args) {
+        using Block = AllocatorBlock<T, Alloc>;
+        using BlockTraits = std::allocator_traits<typename Block::BlockAlloc>;
+
+        typename Block::BlockAlloc block_alloc(alloc);
+        Block* block = BlockTraits::allocate(block_alloc, 1);
+        try {
+            ::new (static_cast<void*>(block)) Block(alloc, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            BlockTraits::deallocate(block_alloc, block, 1);
+            throw;
+        }
+        CountPolicy::adopt(block);
+
+        return BasicSharedPtr<T, CountPolicy>(&block->object, block);
     };
 
-}
+    template<typename T, typename Alloc, typename... Args>
+    SharedPtr<T> allocate_shared(const Alloc& alloc, Args&&... args) {
+        return allocate_basic_shared<T, AtomicCount>(alloc, std::forward<Args>(args)...);
+    };
+
+    template<typename T, typename Alloc, typename... Args>
+    LocalSharedPtr<T> allocate_local_shared(const Alloc& alloc, Args&&... args) {
+        return allocate_basic_shared<T, LocalCount>(alloc, std::forward<Args>(args)...);
+    };
+
+    // --- WeakPtr ---
+    // Observes a SharedPtr's object without keeping it alive.
+    template<typename T, typename CountPolicy = AtomicCount>
+    class BasicWeakPtr {
+    public:
+        constexpr BasicWeakPtr() noexcept = default;
+
+        BasicWeakPtr(const BasicSharedPtr<T, CountPolicy>& shared) noexcept:
+            cb_(shared.cb_), ptr_(shared.ptr_)
+        {
+            if (cb_) {
+                CountPolicy::add_weak(cb_);
+            }
+        };
+
+        BasicWeakPtr(const BasicWeakPtr& other) noexcept:
+            cb_(other.cb_), ptr_(other.ptr_)
+        {
+            if (cb_) {
+                CountPolicy::add_weak(cb_);
+            }
+        };
+        BasicWeakPtr(BasicWeakPtr&& other) noexcept:
+            cb_(std::exchange(other.cb_, nullptr)), ptr_(std::exchange(other.ptr_, nullptr))
+        {};
 
+        ~BasicWeakPtr() {
+            if (cb_) {
+                CountPolicy::release_weak(cb_);
+            }
+        };
+
+        BasicWeakPtr& operator=(const BasicWeakPtr& other) noexcept {
+            BasicWeakPtr(other).swap(*this);
+            return *this;
+        };
+        BasicWeakPtr& operator=(BasicWeakPtr&& other) noexcept {
+            BasicWeakPtr(std::move(other)).swap(*this);
+            return *this;
+        };
+        BasicWeakPtr& operator=(const BasicSharedPtr<T, CountPolicy>& shared) noexcept {
+            BasicWeakPtr(shared).swap(*this);
+            return *this;
+        };
+
+        void reset() noexcept {
+            BasicWeakPtr().swap(*this);
+        };
+        void swap(BasicWeakPtr& other) noexcept {
+            std::swap(cb_, other.cb_);
+            std::swap(ptr_, other.ptr_);
+        };
+
+        // A SharedPtr to the object, or an empty one if it is already gone.
+        // Safe to call while other threads drop the last owner.
+        BasicSharedPtr<T, CountPolicy> lock() const noexcept {
+            if (cb_ && CountPolicy::try_acquire_strong(cb_)) {
+                return BasicSharedPtr<T, CountPolicy>(ptr_, cb_);
+            }
+            return BasicSharedPtr<T, CountPolicy>();
+        };
+
+        long use_count() const noexcept {
+            return (cb_ != nullptr) ? cb_->use_count() : 0;
+        };
+        bool expired() const noexcept {
+            return use_count() == 0;
+        };
+
+    private:
+        ControlBlock* cb_ = nullptr;
+        T* ptr_ = nullptr;
+    };
+
+    template<typename T>
+    using WeakPtr = BasicWeakPtr<T, AtomicCount>;
+    template<typename T>
+    using LocalWeakPtr = BasicWeakPtr<T, LocalCount>;
+
+}
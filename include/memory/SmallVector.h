@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>          // size_t
+#include <utility>          // std::move, std::forward, std::exchange
+#include <new>              // placement new
+#include <cassert>          // assert
+#include <stdexcept>        // std::out_of_range
+#include <memory>           // std::allocator
+
+#include "memory/TypeTraits.h"
+#include "memory/Vector.h"
+
+/*
+   Design thoughts:
+
+   * Most small collections never hold more than a handful of elements, yet a
+   Vector heap-allocates on the first push. SmallVector<T, N> keeps the first N
+   elements in a buffer inside the object (like Array<T, N>, but raw storage so
+   nothing is constructed until it is pushed) and only goes to the heap past N
+
+    * data_ always points at the live elements, inline or on the heap, so every
+    accessor is the same single load as in Vector; is_inline() is just
+    data_ == inline buffer
+
+    * Spilling and growing call Vector's own reallocation step
+    (reallocate_and_build in Vector.h: new element built first, then
+    uninitialized_relocate, one memcpy for trivially relocatable T). It hands
+    the old block back to the caller, so the inline buffer is simply left
+    behind. It never goes back inline (clear() keeps the heap block, like
+    Vector keeps its capacity)
+
+    * Not built on Vector itself: Vector's data_ always owns a heap block
+    (or is null), while here data_ may point into the object. The heap block
+    comes from std::allocator; taking an Allocator parameter would also need
+    Vector's move-assignment rules for unequal allocators on top of the
+    element-wise inline move, and nothing needs it yet
+
+    * Moving a SmallVector steals a heap block, but inline elements have to be
+    relocated one by one: the storage is part of the object
+
+*/
+
+namespace My {
+
+template <typename T, size_t N, typename GrowthPolicy = GrowDouble>
+class SmallVector {
+    static_assert(N > 0, "SmallVector: use Vector<T> for N == 0");
+
+public:
+    // Standard typedefs
+    using iterator = T*;
+    using const_iterator = const T*;
+    using value_type = T;
+    using size_type = size_t;
+
+    // --- Constructors / Destructor ---
+    SmallVector() noexcept: data_(inline_data()), size_(0), capacity_(N) {};
+    ~SmallVector() {
+        clear();
+        release_heap();
+    };
+
+    // Disable Copy (like Vector)
+    SmallVector(const SmallVector&) = delete;
+    SmallVector& operator=(const SmallVector&) = delete;
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>):
+        data_(inline_data()), size_(0), capacity_(N)
+    {
+        take(other);
+    };
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release_heap();
+            data_ = inline_data();
+            capacity_ = N;
+            take(other);
+        }
+        return *this;
+    };
+
+    // --- Core Memory Operations ---
+
+    // Moves to the heap if new_cap > N. Never shrinks.
+    void reserve(size_t new_cap) {
+        if (new_cap <= capacity_) return;
+
+        std::allocator<T> alloc;
+        T* new_data = reallocate(alloc, data_, size_, new_cap);
+        release_heap();
+        data_ = new_data;
+        capacity_ = new_cap;
+    };
+
+    // Constructs element in-place. Handles growth (and the spill) if needed.
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return grow_and_emplace(std::forward<Args>(args)...);
+        }
+        new (data_ + size_) T(std::forward<Args>(args)...);
+        return data_[size_++];
+    };
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    };
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    };
+
+    void pop_back() {
+        if (size_ > 0) {
+            data_[size_-1].~T();
+            size_--;
+        }
+    };
+    void clear() {
+        //Reverse order is C++ convention
+        for (size_t i = size_; i > 0; i--) {
+            data_[i-1].~T();
+        }
+        size_ = 0;
+    };
+
+    // --- Accessors ---
+    T* data() { return data_; };
+    const T* data() const { return data_; };
+
+    size_t size() const { return size_; };
+    size_t capacity() const { return capacity_; };
+    bool empty() const { return size_ == 0; };
+    static constexpr size_t inline_capacity() { return N; };
+    // Still using the inline buffer (no heap allocation yet)?
+    bool is_inline() const { return data_ == inline_data(); };
+
+    T& operator[](size_t index) {
+        assert(index < size_);
+        return data_[index];
+    };
+    const T& operator[](size_t index) const {
+        assert(index < size_);
+        return data_[index];
+    };
+
+    T& at(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("SmallVector::at -- Index out of range");
+        }
+        return data_[index];
+    };
+    const T& at(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("SmallVector::at -- Index out of range");
+        }
+        return data_[index];
+    };
+
+    T& front() { return data_[0]; };
+    const T& front() const { return data_[0]; };
+    T& back() { return data_[size_-1]; };
+    const T& back() const { return data_[size_-1]; };
+
+    // --- Iterators ---
+    iterator begin() { return data_; };
+    iterator end() { return data_ + size_; };
+    const_iterator begin() const { return data_; };
+    const_iterator end() const { return data_ + size_; };
+    const_iterator cbegin() const { return data_; };
+    const_iterator cend() const { return data_ + size_; };
+
+private:
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(inline_);
+    }
+    const T* inline_data() const noexcept {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        }
+    }
+
+    // Takes other's elements into this (empty, inline) vector; leaves other empty.
+    void take(SmallVector& other) {
+        if (!other.is_inline()) {
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+            return;
+        }
+        uninitialized_relocate(other.data_, other.size_, data_);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Slow path of emplace_back: as in Vector, build the new element first
+    // because args may refer to an element we are about to relocate.
+    template <typename... Args>
+    T& grow_and_emplace(Args&&... args) {
+        const size_t new_cap = GrowthPolicy::next(capacity_, size_ + 1);
+        std::allocator<T> alloc;
+        T* new_data = reallocate_and_build(alloc, data_, size_, new_cap, 1, [&](T* dest) {
+            new (dest) T(std::forward<Args>(args)...);
+        });
+        release_heap();
+        data_ = new_data;
+        capacity_ = new_cap;
+        return data_[size_++];
+    }
+
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+    alignas(T) std::byte inline_[N * sizeof(T)];
+};
+
+} // namespace My
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>          // size_t
+#include <utility>          // std::forward, std::index_sequence, std::exchange
+#include <new>              // aligned operator new, placement new
+#include <cassert>          // assert
+#include <algorithm>        // std::max
+#include <span>             // std::span
+#include <tuple>            // std::tuple, std::tuple_element_t
+#include <type_traits>      // std::is_nothrow_move_constructible_v
+#include <memory>           // std::destroy_at
+
+#include "memory/TypeTraits.h"
+#include "memory/Vector.h"
+
+/*
+   Design thoughts:
+
+   * Vector<Order> is an array of structs: a scan that reads 2 fields out of 8
+   still drags the other 6 through the cache. SoaVector<Fields...> keeps one
+   contiguous column per field instead, so the scan only touches the columns it
+   reads and every byte it loads is useful (and the loop vectorises)
+
+    * Columns:
+        - each its own block, aligned to a cache line, all with the same size
+        and capacity (one size_/capacity_ for the whole table)
+        - grow together with the same GrowthPolicy as Vector, each column
+        relocated with uninitialized_relocate (memcpy for trivial fields)
+        - column<I>() hands out a std::span for the hot loops
+
+    * Rows:
+        - there is no Order object anywhere, so operator[] returns a proxy:
+        std::tuple<Fields&...>. Structured bindings work on it directly
+            auto [price, qty] = orders[i];   // references into the columns
+        and assigning a tuple to it writes every column
+
+    * Columns must be nothrow movable: growth relocates them one after the
+    other, and a throw halfway would leave the table with columns in two blocks
+
+*/
+
+namespace My {
+
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector: needs at least one column");
+    static_assert((std::is_nothrow_move_constructible_v<Fields> && ...),
+                  "SoaVector: columns must be nothrow move constructible");
+
+public:
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using value_type = std::tuple<Fields...>;
+    using size_type = size_t;
+
+    template <size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    static constexpr size_t kColumns = sizeof...(Fields);
+
+    // --- Constructors / Destructor ---
+    SoaVector() = default;
+    ~SoaVector() {
+        clear();
+        free_columns(columns_);
+    };
+
+    // Disable Copy (like Vector)
+    SoaVector(const SoaVector&) = delete;
+    SoaVector& operator=(const SoaVector&) = delete;
+
+    SoaVector(SoaVector&& other) noexcept:
+        columns_(std::exchange(other.columns_, {})),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0))
+    {};
+    SoaVector& operator=(SoaVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            free_columns(columns_);
+            columns_ = std::exchange(other.columns_, {});
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    };
+
+    // --- Core Memory Operations ---
+
+    void reserve(size_t new_cap) {
+        if (new_cap <= capacity_) return;
+
+        std::tuple<Fields*...> new_columns = allocate_columns(new_cap);
+        relocate_columns(new_columns, std::index_sequence_for<Fields...>{});
+        free_columns(columns_);
+        columns_ = new_columns;
+        capacity_ = new_cap;
+    };
+
+    // One argument per column, each forwarded to that column's constructor.
+    // The arguments must not refer to our own elements (growth moves them);
+    // push_back takes copies first and has no such restriction.
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == kColumns, "SoaVector::emplace_back - one argument per column");
+        if (size_ == capacity_) {
+            reserve(GrowDouble::next(capacity_, size_ + 1));
+        }
+        construct_row(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+        size_++;
+        return (*this)[size_ - 1];
+    };
+
+    void push_back(Fields... values) {
+        emplace_back(std::move(values)...);
+    };
+
+    void pop_back() {
+        if (size_ > 0) {
+            destroy_row(size_ - 1, std::index_sequence_for<Fields...>{});
+            size_--;
+        }
+    };
+    void clear() {
+        //Reverse order is C++ convention
+        for (size_t i = size_; i > 0; i--) {
+            destroy_row(i - 1, std::index_sequence_for<Fields...>{});
+        }
+        size_ = 0;
+    };
+
+    // --- Columns ---
+
+    template <size_t I>
+    std::span<column_type<I>> column() noexcept {
+        return std::span<column_type<I>>(std::get<I>(columns_), size_);
+    };
+    template <size_t I>
+    std::span<const column_type<I>> column() const noexcept {
+        return std::span<const column_type<I>>(std::get<I>(columns_), size_);
+    };
+
+    // --- Rows ---
+
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return std::apply([index](Fields*... column) { return reference(column[index]...); }, columns_);
+    };
+    const_reference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return std::apply([index](Fields*... column) { return const_reference(column[index]...); }, columns_);
+    };
+
+    reference front() noexcept { return (*this)[0]; };
+    const_reference front() const noexcept { return (*this)[0]; };
+    reference back() noexcept { return (*this)[size_ - 1]; };
+    const_reference back() const noexcept { return (*this)[size_ - 1]; };
+
+    // --- Observers ---
+    size_t size() const noexcept { return size_; };
+    size_t capacity() const noexcept { return capacity_; };
+    bool empty() const noexcept { return size_ == 0; };
+
+private:
+    // Every column starts on its own cache line (more for over-aligned fields).
+    template <typename T>
+    static constexpr size_t kAlign = std::max<size_t>(64, alignof(T));
+
+    static std::tuple<Fields*...> allocate_columns(size_t count) {
+        std::tuple<Fields*...> columns{};
+        try {
+            std::apply([&](Fields*&... column) {
+                ((column = static_cast<Fields*>(::operator new(count * sizeof(Fields), std::align_val_t{kAlign<Fields>}))), ...);
+            }, columns);
+        }
+        catch (...) {
+            //Columns past the failed one are still nullptr
+            free_columns(columns);
+            throw;
+        }
+        return columns;
+    }
+
+    static void free_columns(std::tuple<Fields*...>& columns) noexcept {
+        std::apply([](Fields*&... column) {
+            ((column != nullptr ? ::operator delete(column, std::align_val_t{kAlign<Fields>}) : void()), ...);
+        }, columns);
+    }
+
+    template <size_t... I>
+    void relocate_columns(std::tuple<Fields*...>& dest, std::index_sequence<I...>) noexcept {
+        (uninitialized_relocate(std::get<I>(columns_), size_, std::get<I>(dest)), ...);
+    }
+
+    // Builds row size_ column by column; on a throw the columns already built
+    // are destroyed again.
+    template <size_t... I, typename... Args>
+    void construct_row(std::index_sequence<I...>, Args&&... args) {
+        size_t built = 0;
+        try {
+            ((new (std::get<I>(columns_) + size_) column_type<I>(std::forward<Args>(args)), built++), ...);
+        }
+        catch (...) {
+            ((I < built ? std::destroy_at(std::get<I>(columns_) + size_) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void destroy_row(size_t index, std::index_sequence<I...>) noexcept {
+        (std::destroy_at(std::get<I>(columns_) + index), ...);
+    }
+
+    std::tuple<Fields*...> columns_{};
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+} // namespace My
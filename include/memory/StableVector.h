@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstddef>          // size_t, std::ptrdiff_t
+#include <utility>          // std::forward, std::exchange
+#include <new>              // aligned operator new, placement new
+#include <cassert>          // assert
+#include <stdexcept>        // std::out_of_range
+#include <algorithm>        // std::max
+#include <bit>              // std::has_single_bit, std::bit_floor, std::countr_zero
+#include <iterator>         // std::random_access_iterator_tag
+#include <span>             // std::span
+#include <type_traits>      // std::conditional_t
+#include <memory>           // std::destroy_at
+
+#include "memory/Vector.h"
+
+/*
+   Design thoughts:
+
+   * Vector's growth copies every element into a new block: with tens of
+   millions of elements that one push_back takes milliseconds, and every
+   pointer into the old block dangles. StableVector<T, ChunkSize> stores
+   elements in fixed-size chunks instead, and growing means allocating one more
+   chunk. Existing elements never move:
+        - no growth spike (the worst push_back is one chunk allocation)
+        - pointers and references stay valid until the element is popped
+
+    * Indexing: ChunkSize is a power of two, so
+        element i = chunks_[i >> kShift][i & kMask]
+    two loads instead of Vector's one, but no division
+
+    * The chunk table is a Vector<T*>. It still doubles, but it holds one
+    pointer per chunk (a 10M-element table of doubles is ~5k pointers), and
+    moving pointers does not move the elements they point to
+
+    * Chunks:
+        - the default ChunkSize is ~16 KiB worth of elements
+        - each chunk is aligned to a cache line, and chunk(c) hands out its
+        live elements as a std::span. Hot loops go chunk by chunk and run over
+        plain contiguous memory (vectorisable), instead of paying the
+        shift/mask per element through operator[] or the iterators
+        - pop_back/clear keep the chunks (like Vector keeps its capacity);
+        shrink_to_fit frees the empty ones
+
+*/
+
+namespace My {
+
+// ~16 KiB of elements per chunk, rounded down to a power of two (at least 1).
+template <typename T>
+inline constexpr size_t kDefaultChunkSize = std::bit_floor(std::max<size_t>(1, 16384 / sizeof(T)));
+
+template <typename T, size_t ChunkSize = kDefaultChunkSize<T>>
+class StableVector {
+    static_assert(std::has_single_bit(ChunkSize), "StableVector: ChunkSize must be a power of two");
+
+    template <bool Const>
+    class Iterator;
+
+public:
+    // Standard typedefs
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    static constexpr size_t kChunkSize = ChunkSize;
+
+    // --- Constructors / Destructor ---
+    StableVector() = default;
+    ~StableVector() {
+        clear();
+        free_chunks(0);
+    };
+
+    // Disable Copy (like Vector)
+    StableVector(const StableVector&) = delete;
+    StableVector& operator=(const StableVector&) = delete;
+
+    //Moving moves the chunk table; the elements stay where they are
+    StableVector(StableVector&& other) noexcept:
+        chunks_(std::move(other.chunks_)),
+        size_(std::exchange(other.size_, 0))
+    {};
+    StableVector& operator=(StableVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            free_chunks(0);
+            chunks_ = std::move(other.chunks_);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    };
+
+    // --- Core Memory Operations ---
+
+    // Allocates chunks up front until capacity() >= new_cap.
+    void reserve(size_t new_cap) {
+        while (capacity() < new_cap) {
+            add_chunk();
+        }
+    };
+
+    // Never relocates: args may refer to our own elements.
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity()) {
+            add_chunk();
+        }
+        T* slot = chunks_[size_ >> kShift] + (size_ & kMask);
+        new (slot) T(std::forward<Args>(args)...);
+        size_++;
+        return *slot;
+    };
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    };
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    };
+
+    void pop_back() {
+        if (size_ > 0) {
+            std::destroy_at(&(*this)[size_ - 1]);
+            size_--;
+        }
+    };
+    void clear() {
+        //Reverse order is C++ convention
+        for (size_t i = size_; i > 0; i--) {
+            std::destroy_at(&(*this)[i - 1]);
+        }
+        size_ = 0;
+    };
+
+    // Frees the chunks past the last element.
+    void shrink_to_fit() {
+        free_chunks(chunks_for(size_));
+        chunks_.shrink_to_fit();
+    };
+
+    // --- Accessors ---
+    size_t size() const noexcept { return size_; };
+    size_t capacity() const noexcept { return chunks_.size() * ChunkSize; };
+    bool empty() const noexcept { return size_ == 0; };
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return chunks_[index >> kShift][index & kMask];
+    };
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return chunks_[index >> kShift][index & kMask];
+    };
+
+    T& at(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("StableVector::at -- Index out of range");
+        }
+        return (*this)[index];
+    };
+    const T& at(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("StableVector::at -- Index out of range");
+        }
+        return (*this)[index];
+    };
+
+    T& front() { return (*this)[0]; };
+    const T& front() const { return (*this)[0]; };
+    T& back() { return (*this)[size_ - 1]; };
+    const T& back() const { return (*this)[size_ - 1]; };
+
+    // --- Chunks ---
+    // for (size_t c = 0; c < v.chunk_count(); ++c)
+    //     for (double x : v.chunk(c)) ...        // contiguous inner loop
+
+    // Chunks holding at least one element.
+    size_t chunk_count() const noexcept { return chunks_for(size_); };
+
+    // Live elements of chunk c: ChunkSize of them, fewer in the last chunk.
+    std::span<T> chunk(size_t c) noexcept {
+        assert(c < chunk_count());
+        return std::span<T>(chunks_[c], chunk_length(c));
+    };
+    std::span<const T> chunk(size_t c) const noexcept {
+        assert(c < chunk_count());
+        return std::span<const T>(chunks_[c], chunk_length(c));
+    };
+
+    // --- Iterators ---
+    iterator begin() noexcept { return iterator(this, 0); };
+    iterator end() noexcept { return iterator(this, size_); };
+    const_iterator begin() const noexcept { return const_iterator(this, 0); };
+    const_iterator end() const noexcept { return const_iterator(this, size_); };
+    const_iterator cbegin() const noexcept { return begin(); };
+    const_iterator cend() const noexcept { return end(); };
+
+private:
+    static constexpr size_t kShift = std::countr_zero(ChunkSize);
+    static constexpr size_t kMask = ChunkSize - 1;
+    static constexpr size_t kAlign = std::max<size_t>(64, alignof(T));
+
+    // Random access by index, like CircularBuffer's: a container pointer and
+    // an index, so it never dangles when a chunk is added.
+    template <bool Const>
+    class Iterator {
+        using Container = std::conditional_t<Const, const StableVector, StableVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+        Iterator(Container* container, size_t index): container_(container), index_(index) {};
+        // iterator -> const_iterator
+        operator Iterator<true>() const noexcept requires (!Const) {
+            return Iterator<true>(container_, index_);
+        };
+
+        reference operator*() const noexcept { return (*container_)[index_]; };
+        pointer operator->() const noexcept { return &(*container_)[index_]; };
+        reference operator[](difference_type n) const noexcept { return (*container_)[index_ + n]; };
+
+        Iterator& operator++() noexcept { ++index_; return *this; };
+        Iterator operator++(int) noexcept { Iterator old = *this; ++index_; return old; };
+        Iterator& operator--() noexcept { --index_; return *this; };
+        Iterator operator--(int) noexcept { Iterator old = *this; --index_; return old; };
+        Iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; };
+        Iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; };
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; };
+        friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; };
+        friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; };
+        friend difference_type operator-(const Iterator& a, const Iterator& b) noexcept {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        };
+        friend bool operator==(const Iterator& a, const Iterator& b) noexcept { return a.index_ == b.index_; };
+        friend auto operator<=>(const Iterator& a, const Iterator& b) noexcept { return a.index_ <=> b.index_; };
+
+    private:
+        Container* container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    static size_t chunks_for(size_t count) noexcept {
+        return (count + kMask) >> kShift;
+    }
+
+    size_t chunk_length(size_t c) const noexcept {
+        return std::min(ChunkSize, size_ - (c << kShift));
+    }
+
+    void add_chunk() {
+        T* chunk = static_cast<T*>(::operator new(ChunkSize * sizeof(T), std::align_val_t{kAlign}));
+        try {
+            chunks_.push_back(chunk);
+        }
+        catch (...) {
+            ::operator delete(chunk, std::align_val_t{kAlign});
+            throw;
+        }
+    }
+
+    // Frees chunks [keep, end) of the table. They must hold no elements.
+    void free_chunks(size_t keep) noexcept {
+        while (chunks_.size() > keep) {
+            ::operator delete(chunks_.back(), std::align_val_t{kAlign});
+            chunks_.pop_back();
+        }
+    }
+
+    Vector<T*> chunks_;
+    size_t size_ = 0;
+};
+
+} // namespace My
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>          // size_t
+#include <cstring>          // std::memcpy
+#include <new>              // placement new
+#include <type_traits>      // std::is_trivially_copyable
+#include <utility>          // std::move_if_noexcept
+
+/*
+   Design thoughts:
+
+   * "Relocate" = move an object to new storage and end the old one, i.e.
+   move-construct + destroy. For most types that is just copying the bytes:
+   nothing points into the object itself, so the byte copy IS the object
+        - Trivially copyable types are relocatable by definition
+        - Many other types are too (std::unique_ptr, most handles, our own
+        containers), but the compiler cannot know. is_trivially_relocatable is
+        the opt-in: specialise it to std::true_type for such a type
+        - Do NOT opt in a type that stores pointers into itself (small-buffer
+        strings, intrusive list heads, ...)
+
+    * uninitialized_relocate picks the cheapest correct way:
+        - relocatable: one memcpy for the whole range
+        - otherwise: move if the move constructor is noexcept (or there is no
+        copy), else copy. Only then can a throw halfway leave the source intact
+        (strong exception guarantee, as std::vector gives)
+
+*/
+
+namespace My {
+
+// Opt-in trait: specialise to std::true_type for types that can be moved with memcpy.
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Relocates count objects from first into uninitialised dest.
+// On success the source objects are gone (destroyed or bitwise moved away).
+// If a copy throws, the source is untouched and dest holds nothing.
+template <typename T>
+void uninitialized_relocate(T* first, size_t count, T* dest) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+        }
+    }
+    else {
+        size_t built = 0;
+        try {
+            for (; built < count; built++) {
+                new (dest + built) T(std::move_if_noexcept(first[built]));
+            }
+        }
+        catch (...) {
+            for (size_t i = built; i > 0; i--) {
+                dest[i-1].~T();
+            }
+            throw;
+        }
+        for (size_t i = count; i > 0; i--) {
+            first[i-1].~T();
+        }
+    }
+}
+
+} // namespace My
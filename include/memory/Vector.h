@@ -6,27 +6,145 @@
 #include <cassert>          // assert
 #include <stdexcept>        // std::out_of_range
 #include <initializer_list> // std::initializer_list
+#include <algorithm>        // std::max, std::rotate, std::move
+#include <iterator>         // iterator concepts, std::distance
+#include <memory>           // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <type_traits>      // std::is_same_v
+#include <cstring>          // std::memcpy
+
+#include "memory/TypeTraits.h"
+
+/*
+   Design thoughts:
+
+   * Growth is a policy (GrowthPolicy::next(capacity, needed) -> new capacity):
+        - GrowDouble: the classic 2x, fewest reallocations
+        - GrowOneAndHalf: 1.5x, less slack, and a freed block can eventually
+        be reused by a later one (with 2x the sum of the old blocks is always
+        smaller than the next request)
+        - GrowExact: exactly what is needed, for sizes known up front
+
+    * Moving elements to the new block goes through uninitialized_relocate
+    (TypeTraits.h): one memcpy for trivially relocatable T, otherwise
+    move_if_noexcept per element, so a throwing move never breaks the strong
+    guarantee of reserve()
+
+    * emplace_back builds the new element in the new block BEFORE relocating
+    the old ones, so v.push_back(v[0]) is fine even when it reallocates
+
+    * Allocator-aware (third parameter, std::allocator by default):
+        - memory comes from allocator_traits::allocate/deallocate, elements are
+        built and destroyed through allocator_traits::construct/destroy (so a
+        pmr allocator passes its resource on to pmr elements)
+        - Relocation during growth still memcpys or moves: a moved element
+        keeps the allocator it was built with, which is ours
+        - Move construction always steals the block (and the allocator). Move
+        assignment steals only if the allocator propagates on move assignment
+        or the two allocators are equal; otherwise the memory belongs to a
+        different resource and the elements are moved over one by one
+        - My::pmr::Vector<T> is the std::pmr::polymorphic_allocator flavour,
+        e.g. on a std::pmr::monotonic_buffer_resource released once per tick
+
+    * Bulk operations (append, assign, insert of a range or a count, resize)
+    reserve ONCE and then construct the whole run, instead of a loop of
+    emplace_back with a capacity check per element:
+        - a contiguous range of trivially copyable T is one memcpy
+        - when the run needs a new block it is built in the new block first
+        (same as emplace_back), so appending a range of the vector itself works
+        - insert in the middle = append at the end + std::rotate into place
+    resize_for_overwrite default-initialises (no zeroing for trivial T) for
+    buffers that are filled through data() right after
+
+*/
 
 namespace My {
 
-template <typename T>
+// --- Growth Policies ---
+
+struct GrowDouble {
+    static constexpr size_t next(size_t capacity, size_t needed) noexcept {
+        return std::max(needed, (capacity == 0) ? size_t(2) : capacity * 2);
+    }
+};
+
+struct GrowOneAndHalf {
+    static constexpr size_t next(size_t capacity, size_t needed) noexcept {
+        return std::max(needed, (capacity < 2) ? size_t(2) : capacity + capacity / 2);
+    }
+};
+
+struct GrowExact {
+    static constexpr size_t next(size_t, size_t needed) noexcept {
+        return needed;
+    }
+};
+
+// --- Reallocation (shared with SmallVector) ---
+
+// Allocates new_cap elements from alloc, builds count new elements after the
+// size old ones with build(dest), then relocates the old ones from data. The
+// new elements are built FIRST: their source may be in the old block. Returns
+// the new block; the old one is left to the caller (SmallVector's may be its
+// inline buffer). If anything throws, nothing has changed.
+template <typename T, typename Allocator, typename Build>
+T* reallocate_and_build(Allocator& alloc, T* data, size_t size, size_t new_cap, size_t count, Build build) {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    T* new_data = AllocTraits::allocate(alloc, new_cap);
+
+    try {
+        build(new_data + size);
+    }
+    catch (...) {
+        AllocTraits::deallocate(alloc, new_data, new_cap);
+        throw;
+    }
+    try {
+        uninitialized_relocate(data, size, new_data);
+    }
+    catch (...) {
+        //Reverse order is C++ convention
+        for (size_t i = count; i > 0; i--) {
+            AllocTraits::destroy(alloc, new_data + size + i - 1);
+        }
+        AllocTraits::deallocate(alloc, new_data, new_cap);
+        throw;
+    }
+    return new_data;
+}
+
+// Same, with no new elements (reserve, shrink_to_fit).
+template <typename T, typename Allocator>
+T* reallocate(Allocator& alloc, T* data, size_t size, size_t new_cap) {
+    return reallocate_and_build(alloc, data, size, new_cap, 0, [](T*) {});
+}
+
+template <typename T, typename GrowthPolicy = GrowDouble, typename Allocator = std::allocator<T>>
 class Vector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                  "Vector: Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>,
+                  "Vector: fancy allocator pointers are not supported");
+
+    // Can a moved-to vector simply take over the other one's block?
+    static constexpr bool kMoveAssignSteals =
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value;
+
 public:
     // Standard typedefs
     using iterator = T*;
     using const_iterator = const T*;
     using value_type = T;
     using size_type = size_t;
+    using allocator_type = Allocator;
 
     // --- Constructors / Destructor ---
     Vector(): data_(nullptr), size_(0), capacity_(0) {};
+    explicit Vector(const Allocator& alloc): alloc_(alloc), data_(nullptr), size_(0), capacity_(0) {};
     ~Vector(){
-        //Reverse order is C++ convention
-        for (size_t i = size_; i > 0; i--) {
-            data_[i-1].~T();
-        }
-
-        ::operator delete(data_);
+        clear();
+        deallocate(data_, capacity_);
     };
 
     // Disable Copy (HFT Strictness)
@@ -34,8 +152,43 @@ public:
     Vector& operator=(const Vector&) = delete;
 
     // Move Semantics (Required)
-    Vector(Vector&& other) noexcept;
-    Vector& operator=(Vector&& other) noexcept;
+    Vector(Vector&& other) noexcept:
+        alloc_(std::move(other.alloc_)),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0))
+    {};
+
+    Vector& operator=(Vector&& other) noexcept(kMoveAssignSteals) {
+        if (this == &other) {
+            return *this;
+        }
+        if (kMoveAssignSteals || alloc_ == other.alloc_) {
+            clear();
+            deallocate(data_, capacity_);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+            }
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        else {
+            //Different resources: we cannot free their block, so move the elements
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; i++) {
+                AllocTraits::construct(alloc_, data_ + i, std::move(other.data_[i]));
+                size_++;
+            }
+            other.clear();
+        }
+        return *this;
+    };
+
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    };
 
     // --- Core Memory Operations ---
 
@@ -44,22 +197,11 @@ public:
 
         if (new_cap <= capacity_) return;
 
-        //1) Allocate new memory
-        // new operator
-        T* new_data = static_cast<T*>(::operator new(new_cap*sizeof(T)));
-
+        //1) Allocate new memory and relocate old data (memcpy, move or copy, see TypeTraits.h)
+        T* new_data = reallocate(alloc_, data_, size_, new_cap);
 
-        //2) Move old data
-        // placement new (with move commands)
-        for (size_t i=0; i < size_; i++) {
-            new (new_data + i) T(std::move(data_[i]));
-
-            //Release the old data
-            data_[i].~T();
-        }
-
-        //3) Destroy and free old data location
-        ::operator delete(data_);
+        //2) Free old data location
+        deallocate(data_, capacity_);
 
         data_ = new_data;
         capacity_ = new_cap;
@@ -69,13 +211,15 @@ public:
     template <typename... Args>
     T& emplace_back(Args&&... args) {
         if (size_ == capacity_) {
-            //Expand
-            size_t new_cap = (capacity_ == 0) ? 2 : capacity_*2;
-            reserve(new_cap);
+            //Args may refer to one of our elements: build before relocating
+            grow_with(GrowthPolicy::next(capacity_, size_ + 1), 1, [&](T* dest) {
+                AllocTraits::construct(alloc_, dest, std::forward<Args>(args)...);
+            });
+            return data_[size_-1];
         }
 
-        //Placement new
-        new (data_ + size_) T(std::forward<Args>(args)...);
+        //Placement new (through the allocator)
+        AllocTraits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
 
         T& ref = data_[size_];
         size_++;
@@ -94,25 +238,126 @@ public:
 
     void pop_back() {
         if (size_ > 0) {
-            data_[size_-1].~T();
+            AllocTraits::destroy(alloc_, data_ + size_ - 1);
             size_--;
         }
     };
     void clear(){
+        //Reverse order is C++ convention
         for (size_t i=size_; i > 0; i--) {
-            data_[i-1].~T();
+            AllocTraits::destroy(alloc_, data_ + i - 1);
         }
         //Reset size, but keep capacity
         size_ = 0;
     };
 
+    // --- Bulk Operations ---
+
+    // Appends [first, last). One reservation for forward ranges.
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    void append(It first, Sent last) {
+        if constexpr (std::forward_iterator<It>) {
+            const size_t count = static_cast<size_t>(std::ranges::distance(first, last));
+            append_with(count, [&](T* dest) { construct_copies(dest, first, count); });
+        }
+        else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    };
+
+    // Replaces the contents with [first, last) (which must not be our own elements).
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    void assign(It first, Sent last) {
+        clear();
+        append(first, last);
+    };
+
+    // Inserts before pos; returns an iterator to the first inserted element.
+    iterator insert(const_iterator pos, const T& value) {
+        return emplace(pos, value);
+    };
+    iterator insert(const_iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    };
+    iterator insert(const_iterator pos, size_t count, const T& value) {
+        const size_t index = pos - data_;
+        append_with(count, [&](T* dest) { construct_fill(dest, count, value); });
+        return rotate_into_place(index, count);
+    };
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    iterator insert(const_iterator pos, It first, Sent last) {
+        const size_t index = pos - data_;
+        const size_t old_size = size_;
+        append(first, last);
+        return rotate_into_place(index, size_ - old_size);
+    };
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_t index = pos - data_;
+        emplace_back(std::forward<Args>(args)...);
+        return rotate_into_place(index, 1);
+    };
+
+    // Removes [first, last); returns an iterator to the element after them.
+    iterator erase(const_iterator first, const_iterator last) {
+        T* gap = data_ + (first - data_);
+        const size_t count = last - first;
+        if (count == 0) {
+            return gap;
+        }
+        //Slide the tail down over the gap, then destroy the moved-from end
+        T* new_end = std::move(gap + count, data_ + size_, gap);
+        for (T* p = data_ + size_; p != new_end; p--) {
+            AllocTraits::destroy(alloc_, p - 1);
+        }
+        size_ -= count;
+        return gap;
+    };
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    };
+
+    // New elements are value-initialised (zero for trivial T).
+    void resize(size_t count) {
+        resize_with(count, [&](T* dest, size_t n) { construct_default(dest, n); });
+    };
+    void resize(size_t count, const T& value) {
+        resize_with(count, [&](T* dest, size_t n) { construct_fill(dest, n, value); });
+    };
+
+    // Like resize, but new elements are default-initialised: trivial T is left
+    // uninitialised, for buffers about to be filled through data().
+    void resize_for_overwrite(size_t count) {
+        resize_with(count, [&](T* dest, size_t n) {
+            construct_n(dest, n, [](T* p) { ::new (static_cast<void*>(p)) T; });
+        });
+    };
+
+    // Reallocates to exactly size() (frees the block if empty).
+    void shrink_to_fit() {
+        if (size_ == capacity_) return;
+        if (size_ == 0) {
+            deallocate(data_, capacity_);
+            data_ = nullptr;
+            capacity_ = 0;
+            return;
+        }
+        T* new_data = reallocate(alloc_, data_, size_, size_);
+        deallocate(data_, capacity_);
+        data_ = new_data;
+        capacity_ = size_;
+    };
+
 
     // --- Accessors ---
     T* data() {
-        return &data_[0];
+        return data_;
     };
     const T* data() const {
-        return &data_[0];
+        return data_;
     };
 
     size_t size() const { return size_;};
@@ -157,16 +402,123 @@ public:
     };
 
     // --- Iterators ---
-    iterator begin();
-    iterator end();
-    const_iterator begin() const;
-    const_iterator end() const;
+    iterator begin() { return data_; };
+    iterator end() { return data_ + size_; };
+    const_iterator begin() const { return data_; };
+    const_iterator end() const { return data_ + size_; };
+    const_iterator cbegin() const { return data_; };
+    const_iterator cend() const { return data_ + size_; };
 
 private:
+    // Is AllocTraits::construct just placement new for trivially copyable T?
+    static constexpr bool kPlainConstruct =
+        std::is_same_v<Allocator, std::allocator<T>> ||
+        std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>>;
+
+    // Builds count new elements at the end with build(dest), which must
+    // construct all of them or none. Grows (once) if needed.
+    template <typename Build>
+    void append_with(size_t count, Build build) {
+        if (count == 0) return;
+        if (size_ + count <= capacity_) {
+            build(data_ + size_);
+            size_ += count;
+            return;
+        }
+        grow_with(GrowthPolicy::next(capacity_, size_ + count), count, build);
+    }
+
+    // Moves to a block of new_cap and builds count new elements after the old
+    // ones. The new elements are built FIRST: their source may be in the old block.
+    template <typename Build>
+    void grow_with(size_t new_cap, size_t count, Build build) {
+        T* new_data = reallocate_and_build(alloc_, data_, size_, new_cap, count, build);
+        deallocate(data_, capacity_);
+        data_ = new_data;
+        size_ += count;
+        capacity_ = new_cap;
+    }
+
+    template <typename Build>
+    void resize_with(size_t count, Build build) {
+        if (count <= size_) {
+            destroy_range(data_ + count, size_ - count);
+            size_ = count;
+            return;
+        }
+        const size_t extra = count - size_;
+        append_with(extra, [&](T* dest) { build(dest, extra); });
+    }
+
+    // The count elements just appended at the end move to index; returns it.
+    iterator rotate_into_place(size_t index, size_t count) {
+        std::rotate(data_ + index, data_ + size_ - count, data_ + size_);
+        return data_ + index;
+    }
+
+    // --- All-or-nothing construction into raw memory ---
+
+    template <typename It>
+    void construct_copies(T* dest, It first, size_t count) {
+        if constexpr (kPlainConstruct && std::contiguous_iterator<It> &&
+                      std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, T>) {
+            //memmove semantics are not needed: dest is never inside the source
+            std::memcpy(static_cast<void*>(dest), std::to_address(first), count * sizeof(T));
+        }
+        else {
+            construct_n(dest, count, [&](T* p) { AllocTraits::construct(alloc_, p, *first); ++first; });
+        }
+    }
+
+    void construct_fill(T* dest, size_t count, const T& value) {
+        construct_n(dest, count, [&](T* p) { AllocTraits::construct(alloc_, p, value); });
+    }
+
+    void construct_default(T* dest, size_t count) {
+        construct_n(dest, count, [&](T* p) { AllocTraits::construct(alloc_, p); });
+    }
+
+    template <typename ConstructOne>
+    void construct_n(T* dest, size_t count, ConstructOne construct_one) {
+        size_t built = 0;
+        try {
+            for (; built < count; built++) {
+                construct_one(dest + built);
+            }
+        }
+        catch (...) {
+            destroy_range(dest, built);
+            throw;
+        }
+    }
+
+    void destroy_range(T* first, size_t count) noexcept {
+        //Reverse order is C++ convention
+        for (size_t i = count; i > 0; i--) {
+            AllocTraits::destroy(alloc_, first + i - 1);
+        }
+    }
+
+    void deallocate(T* block, size_t capacity) noexcept {
+        if (block != nullptr) {
+            AllocTraits::deallocate(alloc_, block, capacity);
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_;
     T* data_ = nullptr;
     size_t size_ = 0;
     size_t capacity_ = 0;
 };
 
+namespace pmr {
+
+// Vector on a std::pmr::memory_resource (monotonic arena, pool, ...).
+template <typename T, typename GrowthPolicy = GrowDouble>
+using Vector = My::Vector<T, GrowthPolicy, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace My
 
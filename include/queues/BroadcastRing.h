@@ -0,0 +1,283 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "concurrency/SeqLock.h"
+#include "queues/SlotArray.h"
+
+/*
+   Design thoughts:
+
+   * One producer, N readers, every reader sees every message (disruptor-style)
+        - One SpscRing per reader means the producer copies each message N
+        times. Here it writes each message once into a shared sequence ring
+        and every reader walks the same slots with its own cursor
+        - Producer cost per message is O(1) regardless of N
+
+    * Cursors:
+        - published_: how many messages the producer has made visible
+        - one cursor per reader (how many it has consumed), each on its own
+        cache line, written only by that reader
+        - Like SpscRing, each side caches what it last saw of the other side
+        and only re-reads the shared atomics when the cache says stop
+
+    * BroadcastMode::Blocking
+        - The producer never overwrites a slot some reader has not finished
+        with: it gates on the SLOWEST reader (push returns false when that
+        reader is a full ring behind)
+        - Because slots are stable until the reader advances, readers can use
+        the message in place: peek() -> const T*, then advance()
+        - Slots are constructed on the first lap and assigned over after that,
+        so if T's constructor throws, the slot still holds a live message and
+        nothing is published
+
+    * BroadcastMode::Lossy
+        - The producer never waits. A reader that falls a full ring behind
+        loses messages; read() notices the gap, skips to the oldest message
+        still in the ring and counts what it missed (missed())
+        - Slots can be overwritten while a reader is copying them, so each
+        slot is a SeqLock and read() copies. T must be trivially copyable and
+        there is no in-place peek()
+        - The seqlock version tells the reader which lap a slot holds: slot
+        i has had k writes when its version is 2k, and sequence s is the
+        (s / capacity + 1)-th write to its slot
+
+    * Readers are fixed at construction: reader(i) hands out a cheap handle for
+    reader i, to be used from one thread only
+
+*/
+
+namespace My {
+
+    enum class BroadcastMode {
+        Blocking,  // producer waits for the slowest reader; zero-copy reads
+        Lossy      // producer overwrites; readers detect and count gaps
+    };
+
+    template<typename T, BroadcastMode Mode = BroadcastMode::Blocking>
+    class BroadcastRing {
+        static_assert(Mode == BroadcastMode::Blocking || std::is_trivially_copyable_v<T>,
+                      "BroadcastRing: Lossy mode copies under a seqlock and needs a trivially copyable T");
+
+        struct ReaderState;
+
+    public:
+        // Capacity is rounded up to a power of two.
+        BroadcastRing(size_t size, size_t readers, SlotMemory memory = SlotMemory::Heap):
+            capacity_(std::bit_ceil(std::max<size_t>(size, 1))),
+            mask_(capacity_ - 1),
+            reader_count_(readers),
+            slots_(capacity_, memory),
+            readers_(std::make_unique<ReaderState[]>(readers)),
+            published_(0)
+        {
+            if constexpr (Mode == BroadcastMode::Lossy) {
+                for (size_t i = 0; i < capacity_; i++) {
+                    slots_.construct(i);
+                }
+            }
+        };
+
+        ~BroadcastRing() {
+            //Blocking slots are constructed lazily on the first lap
+            const uint64_t constructed = (Mode == BroadcastMode::Lossy)
+                ? capacity_
+                : std::min<uint64_t>(published_.load(std::memory_order_relaxed), capacity_);
+            for (size_t i = 0; i < constructed; i++) {
+                slots_.destroy(i);
+            }
+        };
+
+        // Non-copyable, Non-movable
+        BroadcastRing(const BroadcastRing&) = delete;
+        BroadcastRing& operator=(const BroadcastRing&) = delete;
+        BroadcastRing(BroadcastRing&&) = delete;
+        BroadcastRing& operator=(BroadcastRing&&) = delete;
+
+        // --- Producer ---
+
+        // Blocking: false if the slowest reader is a full ring behind.
+        // Lossy: always succeeds.
+        bool push(const T& item) {
+            return emplace(item);
+        };
+        bool push(T&& item) {
+            return emplace(std::move(item));
+        };
+
+        template<typename... Args>
+        bool emplace(Args&&... args) {
+            const uint64_t seq = published_.load(std::memory_order_relaxed);
+            if constexpr (Mode == BroadcastMode::Blocking) {
+                if (!has_space(seq)) {
+                    return false;
+                }
+                const size_t index = seq & mask_;
+                if (seq < capacity_) {
+                    slots_.construct(index, std::forward<Args>(args)...);
+                }
+                else {
+                    //Every reader is past the old message. Assign, not destroy +
+                    //construct: a throwing constructor leaves the old one alive
+                    //for ~BroadcastRing to destroy
+                    slots_[index] = T(std::forward<Args>(args)...);
+                }
+            }
+            else {
+                slots_[seq & mask_].write(T(std::forward<Args>(args)...));
+            }
+            //Release to ensure readers see the message
+            published_.store(seq + 1, std::memory_order_release);
+            return true;
+        };
+
+        // --- Readers ---
+
+        class Reader {
+        public:
+            // Blocking only: the next message, in place, or nullptr if none yet.
+            // Valid until advance().
+            const T* peek() requires (Mode == BroadcastMode::Blocking) {
+                if (!ring_->has_data(*state_)) {
+                    return nullptr;
+                }
+                return &ring_->slots_[state_->cursor_cache & ring_->mask_];
+            };
+
+            // Blocking only: done with the message returned by peek().
+            void advance() requires (Mode == BroadcastMode::Blocking) {
+                state_->cursor_cache++;
+                //Release so the producer may reuse the slot
+                state_->cursor.store(state_->cursor_cache, std::memory_order_release);
+            };
+
+            // Copies the next message into out. False if there is none yet.
+            bool read(T& out) {
+                if constexpr (Mode == BroadcastMode::Blocking) {
+                    const T* item = peek();
+                    if (item == nullptr) {
+                        return false;
+                    }
+                    out = *item;
+                    advance();
+                    return true;
+                }
+                else {
+                    return ring_->read_lossy(*state_, out);
+                }
+            };
+
+            // Messages this reader could take right now (snapshot).
+            size_t available() const noexcept {
+                return static_cast<size_t>(ring_->published_.load(std::memory_order_acquire) - state_->cursor_cache);
+            };
+
+            // Lossy only: messages overwritten before this reader got to them.
+            uint64_t missed() const noexcept {
+                return state_->missed;
+            };
+
+        private:
+            friend class BroadcastRing;
+            Reader(BroadcastRing* ring, ReaderState* state): ring_(ring), state_(state) {};
+
+            BroadcastRing* ring_;
+            ReaderState* state_;
+        };
+
+        Reader reader(size_t index) {
+            assert(index < reader_count_ && "BroadcastRing::reader - Index out of range");
+            return Reader(this, &readers_[index]);
+        };
+
+        // --- Observers ---
+
+        size_t capacity() const noexcept {
+            return capacity_;
+        };
+        size_t readers() const noexcept {
+            return reader_count_;
+        };
+        uint64_t published() const noexcept {
+            return published_.load(std::memory_order_acquire);
+        };
+
+    private:
+        // Written by one reader; the producer reads `cursor` when gating.
+        struct alignas(64) ReaderState {
+            std::atomic<uint64_t> cursor{0};   // messages consumed (shared)
+            uint64_t cursor_cache = 0;         // same, reader-private copy
+            uint64_t published_cache = 0;      // last published_ the reader saw
+            uint64_t missed = 0;               // Lossy: messages lost to overwrites
+        };
+
+        using Slot = std::conditional_t<Mode == BroadcastMode::Blocking, T, SeqLock<T>>;
+
+        // Producer side (Blocking): is every reader past seq - capacity?
+        // Only rescans the reader cursors when the cached minimum says no.
+        bool has_space(uint64_t seq) noexcept {
+            if (seq - gate_cache_ < capacity_) {
+                return true;
+            }
+            uint64_t slowest = std::numeric_limits<uint64_t>::max();
+            for (size_t i = 0; i < reader_count_; i++) {
+                //Acquire: the reader is done with the slot before we overwrite it
+                slowest = std::min(slowest, readers_[i].cursor.load(std::memory_order_acquire));
+            }
+            gate_cache_ = (reader_count_ == 0) ? seq : slowest;
+            return seq - gate_cache_ < capacity_;
+        }
+
+        // Reader side: is there a message at the reader's cursor?
+        bool has_data(ReaderState& state) noexcept {
+            if (state.cursor_cache != state.published_cache) {
+                return true;
+            }
+            //Acquire published_ to ensure syncd with the producer
+            state.published_cache = published_.load(std::memory_order_acquire);
+            return state.cursor_cache != state.published_cache;
+        }
+
+        bool read_lossy(ReaderState& state, T& out) noexcept {
+            while (has_data(state)) {
+                const uint64_t seq = state.cursor_cache;
+                const uint64_t expected = 2 * (seq / capacity_ + 1);
+                const uint64_t version = slots_[seq & mask_].read(out);
+                if (version == expected) {
+                    state.cursor_cache = seq + 1;
+                    state.cursor.store(state.cursor_cache, std::memory_order_relaxed);
+                    return true;
+                }
+                //Lapped: jump to the oldest message that can still be in the ring
+                //(one slot of slack for the write that may be in flight)
+                const uint64_t head = published_.load(std::memory_order_acquire);
+                const uint64_t oldest = (head > capacity_ - 1) ? head - (capacity_ - 1) : 0;
+                const uint64_t resume = std::max(oldest, seq + 1);
+                state.missed += resume - seq;
+                state.published_cache = head;
+                state.cursor_cache = resume;
+                state.cursor.store(resume, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        //Read-only after construction
+        alignas(64) const size_t capacity_;
+        const size_t mask_;
+        const size_t reader_count_;
+        SlotArray<Slot> slots_;
+        std::unique_ptr<ReaderState[]> readers_;
+
+        //Producer line
+        alignas(64) std::atomic<uint64_t> published_;
+        uint64_t gate_cache_ = 0;
+    };
+}
@@ -0,0 +1,245 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "queues/SlotArray.h"
+
+/*
+   Design thoughts:
+
+   * SpscRing<T> gives every slot sizeof(T) bytes. With messages from 16 bytes
+   to a few KB that means either max-sized slots (mostly empty) or a pointer per
+   message (a heap allocation per message). ByteRing stores variable-length
+   records back to back in one byte buffer instead
+
+    * Record framing:
+        - an 8-byte header { uint32_t length, uint32_t kind } followed by the
+        payload, the whole record rounded up to 8 bytes so the next header is
+        always aligned
+        - A record is always contiguous, so the consumer gets a plain span.
+        When one does not fit before the end of the buffer, the producer writes
+        a PADDING record over the rest of the buffer and puts the real record at
+        offset 0. The consumer skips padding records
+        - Because the capacity is a power of two and records are multiples of 8,
+        there is always room for at least a header before the end
+
+    * Zero-copy on both sides:
+        - producer: reserve(len) -> span to write into, commit() publishes it
+        - consumer: peek() -> span of the next payload, release() frees it
+        - push()/pop() are the copying conveniences on top
+
+    * Same index scheme as SpscRing: free-running 64-bit BYTE offsets, each on
+    its own cache line, each side caching the other's and re-reading only when
+    the cache says full/empty
+
+    * Largest payload: capacity/2 - 8. Any record that size or smaller fits
+    once the ring drains, wherever the tail happens to be (either it fits before
+    the end, or the padding is short enough that it fits after wrapping)
+
+*/
+
+namespace My {
+
+    class ByteRing {
+    public:
+        // Capacity in bytes, rounded up to a power of two (at least 64).
+        explicit ByteRing(size_t bytes, SlotMemory memory = SlotMemory::Heap):
+            capacity_(std::bit_ceil(std::max<size_t>(bytes, 64))),
+            mask_(capacity_ - 1),
+            buffer_(capacity_, memory),
+            head_(0),
+            tail_(0)
+        {};
+
+        // Non-copyable, Non-movable
+        ByteRing(const ByteRing&) = delete;
+        ByteRing& operator=(const ByteRing&) = delete;
+        ByteRing(ByteRing&&) = delete;
+        ByteRing& operator=(ByteRing&&) = delete;
+
+        // --- Producer ---
+
+        // Contiguous room for a payload of len bytes (1 <= len <= max_message()),
+        // or an empty span if the ring does not have it right now.
+        // Write into it, then publish with commit().
+        std::span<std::byte> reserve(size_t len) noexcept {
+            assert(reserved_ == 0 && "ByteRing::reserve - previous reservation not committed");
+            if (len == 0 || len > max_message()) {
+                return {};
+            }
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            const size_t offset = curr_tail & mask_;
+            const size_t record = record_size(len);
+            //Not enough room before the end: pad to the end and start over at 0
+            const size_t pad = (capacity_ - offset < record) ? capacity_ - offset : 0;
+
+            if (!has_space(curr_tail, pad + record)) {
+                return {};
+            }
+            reserved_ = len;
+            reserved_pad_ = pad;
+            const size_t start = (offset + pad) & mask_;
+            return std::span<std::byte>(buffer_.data() + start + kHeader, len);
+        };
+
+        // Publishes the last reservation, trimmed to len bytes (len <= reserved).
+        // commit(0) abandons it.
+        void commit(size_t len) noexcept {
+            assert(len <= reserved_ && "ByteRing::commit - more than was reserved");
+            if (len == 0) {
+                //Nothing to publish: drop the reservation
+                reserved_ = 0;
+                reserved_pad_ = 0;
+                return;
+            }
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            const size_t offset = curr_tail & mask_;
+            if (reserved_pad_ != 0) {
+                write_header(offset, static_cast<uint32_t>(reserved_pad_ - kHeader), kPadding);
+            }
+            const size_t start = (offset + reserved_pad_) & mask_;
+            write_header(start, static_cast<uint32_t>(len), kData);
+            const uint64_t next = curr_tail + reserved_pad_ + record_size(len);
+            reserved_ = 0;
+            reserved_pad_ = 0;
+            //Release to ensure the consumer sees headers and payload
+            tail_.store(next, std::memory_order_release);
+        };
+
+        // Copies one message in. False if it does not fit right now.
+        bool push(std::span<const std::byte> message) noexcept {
+            std::span<std::byte> dest = reserve(message.size());
+            if (dest.empty()) {
+                return false;
+            }
+            std::memcpy(dest.data(), message.data(), message.size());
+            commit(message.size());
+            return true;
+        };
+
+        // --- Consumer ---
+
+        // The next payload, in place, or an empty span if none is ready.
+        // Valid until release().
+        std::span<const std::byte> peek() noexcept {
+            uint64_t curr_head = head_.load(std::memory_order_relaxed);
+            skipped_ = 0;
+            while (true) {
+                if (curr_head == tail_cache_) {
+                    //Acquire tail_ to ensure syncd with the producer
+                    tail_cache_ = tail_.load(std::memory_order_acquire);
+                    if (curr_head == tail_cache_) {
+                        return {};
+                    }
+                }
+                const size_t offset = curr_head & mask_;
+                uint32_t header[2];
+                std::memcpy(header, buffer_.data() + offset, kHeader);
+                if (header[1] == kPadding) {
+                    //Skip to the start of the buffer; freed with the next release()
+                    curr_head += kHeader + header[0];
+                    skipped_ += kHeader + header[0];
+                    continue;
+                }
+                peeked_ = record_size(header[0]);
+                return std::span<const std::byte>(buffer_.data() + offset + kHeader, header[0]);
+            }
+        };
+
+        // Frees the message returned by the last peek().
+        void release() noexcept {
+            assert(peeked_ != 0 && "ByteRing::release - nothing peeked");
+            const uint64_t curr_head = head_.load(std::memory_order_relaxed);
+            //Release to ensure the producer sees the bytes free
+            head_.store(curr_head + skipped_ + peeked_, std::memory_order_release);
+            skipped_ = 0;
+            peeked_ = 0;
+        };
+
+        // Copies the next message into out and returns its length, or 0 if
+        // none is ready. A message longer than out stays in the ring (also 0);
+        // check next_size() first.
+        size_t pop(std::span<std::byte> out) noexcept {
+            std::span<const std::byte> message = peek();
+            if (message.empty() || message.size() > out.size()) {
+                return 0;
+            }
+            std::memcpy(out.data(), message.data(), message.size());
+            release();
+            return message.size();
+        };
+
+        // Length of the next message, 0 if none is ready.
+        size_t next_size() noexcept {
+            return peek().size();
+        };
+
+        // --- Observers ---
+
+        // Bytes in use, including headers and padding (snapshot).
+        size_t size() const noexcept {
+            const uint64_t curr_head = head_.load(std::memory_order_acquire);
+            const uint64_t curr_tail = tail_.load(std::memory_order_acquire);
+            return static_cast<size_t>(curr_tail - curr_head);
+        };
+        bool empty() const noexcept {
+            return size() == 0;
+        };
+        size_t capacity() const noexcept {
+            return capacity_;
+        };
+        size_t max_message() const noexcept {
+            return capacity_ / 2 - kHeader;
+        };
+        bool huge_pages() const noexcept {
+            return buffer_.huge_pages();
+        };
+
+    private:
+        static constexpr size_t kHeader = 8;
+        static constexpr uint32_t kData = 0;
+        static constexpr uint32_t kPadding = 1;
+
+        static constexpr size_t record_size(size_t len) noexcept {
+            return (kHeader + len + 7) & ~size_t(7);
+        }
+
+        void write_header(size_t offset, uint32_t length, uint32_t kind) noexcept {
+            const uint32_t header[2] = {length, kind};
+            std::memcpy(buffer_.data() + offset, header, kHeader);
+        }
+
+        // Producer side: are there `bytes` free after curr_tail?
+        bool has_space(uint64_t curr_tail, size_t bytes) noexcept {
+            if (curr_tail + bytes - head_cache_ <= capacity_) {
+                return true;
+            }
+            //Acquire head_ to ensure the consumer is done with those bytes
+            head_cache_ = head_.load(std::memory_order_acquire);
+            return curr_tail + bytes - head_cache_ <= capacity_;
+        }
+
+        //Read-only after construction
+        alignas(64) const size_t capacity_;
+        const size_t mask_;
+        SlotArray<std::byte> buffer_;
+
+        //Consumer line
+        alignas(64) std::atomic<uint64_t> head_;
+        uint64_t tail_cache_ = 0;
+        size_t peeked_ = 0;    // size of the record handed out by peek()
+        size_t skipped_ = 0;   // padding peek() stepped over
+
+        //Producer line
+        alignas(64) std::atomic<uint64_t> tail_;
+        uint64_t head_cache_ = 0;
+        size_t reserved_ = 0;      // payload bytes handed out by reserve()
+        size_t reserved_pad_ = 0;  // padding that reserve() planned before it
+    };
+}
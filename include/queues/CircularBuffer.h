@@ -1,16 +1,50 @@
 #pragma once
+#include <algorithm>
+#include <compare>
 #include <cstddef>
+#include <iterator>
 #include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+/*
+   Design thoughts:
+
+   * OverflowPolicy::Overwrite turns the buffer into a rolling window: pushing
+   into a full buffer evicts the oldest element instead of failing
+
+    * The live window is at most two contiguous runs of the storage:
+    [head_, end) and [0, tail_). as_spans() hands those out directly, so a
+    reduction can run over plain arrays with no per-element wrap-around
+
+    * operator[] and the iterators are relative to head_ (index 0 = oldest).
+    The wrap is one compare-and-subtract, not a modulo
+
+*/
+
 namespace My {
 
+    enum class OverflowPolicy {
+        Reject,    // push() on a full buffer returns false
+        Overwrite  // push() on a full buffer evicts the oldest element
+    };
+
     template<typename T>
     class CircularBuffer {
+        template<bool Const>
+        class Iterator;
+
     public:
+        using value_type = T;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
         // Allocates the buffer of given size.
-        explicit CircularBuffer(size_t capacity):
+        explicit CircularBuffer(size_t capacity, OverflowPolicy policy = OverflowPolicy::Reject):
             capacity_(capacity),
+            policy_(policy),
             currSize_(0),
             head_(0),
             tail_(0)
@@ -24,10 +58,11 @@ namespace My {
 
         // Adds item to the buffer.
         // Returns true if successful.
-        // Returns false if buffer is full.
+        // Returns false if buffer is full (Reject), or evicts the oldest
+        // element and returns true (Overwrite; false only at capacity 0).
         bool push(const T& item) {
             if (currSize_ == capacity_) {
-                return false;
+                return overwrite(item);
             }
             else {
                 //TODO: Have we done the ordering properly?
@@ -39,7 +74,7 @@ namespace My {
         };
         bool push(T&& item) {
             if (currSize_ == capacity_) {
-                return false;
+                return overwrite(std::move(item));
             }
             else {
                 //TODO: Have we done the ordering properly?
@@ -68,6 +103,49 @@ namespace My {
             }
         };
 
+        // --- Element Access (index 0 = oldest) ---
+
+        T& operator[](size_t index) noexcept {
+            return buff[physical(index)];
+        };
+        const T& operator[](size_t index) const noexcept {
+            return buff[physical(index)];
+        };
+        T& front() noexcept {
+            return buff[head_];
+        };
+        const T& front() const noexcept {
+            return buff[head_];
+        };
+        T& back() noexcept {
+            return buff[physical(currSize_ - 1)];
+        };
+        const T& back() const noexcept {
+            return buff[physical(currSize_ - 1)];
+        };
+
+        // The live window, oldest first, as at most two contiguous runs.
+        // second is empty unless the window wraps.
+        std::pair<std::span<T>, std::span<T>> as_spans() noexcept {
+            const size_t first = std::min(currSize_, capacity_ - head_);
+            return {std::span<T>(buff.data() + head_, first),
+                    std::span<T>(buff.data(), currSize_ - first)};
+        };
+        std::pair<std::span<const T>, std::span<const T>> as_spans() const noexcept {
+            const size_t first = std::min(currSize_, capacity_ - head_);
+            return {std::span<const T>(buff.data() + head_, first),
+                    std::span<const T>(buff.data(), currSize_ - first)};
+        };
+
+        // --- Iterators (oldest to newest) ---
+
+        iterator begin() noexcept { return iterator(this, 0); };
+        iterator end() noexcept { return iterator(this, currSize_); };
+        const_iterator begin() const noexcept { return const_iterator(this, 0); };
+        const_iterator end() const noexcept { return const_iterator(this, currSize_); };
+        const_iterator cbegin() const noexcept { return begin(); };
+        const_iterator cend() const noexcept { return end(); };
+
         // --- Observers ---
 
         bool empty() const noexcept {
@@ -82,9 +160,78 @@ namespace My {
         size_t capacity() const noexcept {
             return capacity_;
         };
+        OverflowPolicy policy() const noexcept {
+            return policy_;
+        };
 
     private:
+        // Random access over the live window; just a buffer pointer and a
+        // logical index, so it stays valid across wrap-around.
+        template<bool Const>
+        class Iterator {
+            using Buffer = std::conditional_t<Const, const CircularBuffer, CircularBuffer>;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            Iterator() = default;
+            Iterator(Buffer* buffer, size_t index): buffer_(buffer), index_(index) {};
+            // iterator -> const_iterator
+            operator Iterator<true>() const noexcept requires (!Const) {
+                return Iterator<true>(buffer_, index_);
+            };
+
+            reference operator*() const noexcept { return (*buffer_)[index_]; };
+            pointer operator->() const noexcept { return &(*buffer_)[index_]; };
+            reference operator[](difference_type n) const noexcept { return (*buffer_)[index_ + n]; };
+
+            Iterator& operator++() noexcept { ++index_; return *this; };
+            Iterator operator++(int) noexcept { Iterator old = *this; ++index_; return old; };
+            Iterator& operator--() noexcept { --index_; return *this; };
+            Iterator operator--(int) noexcept { Iterator old = *this; --index_; return old; };
+            Iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; };
+            Iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; };
+
+            friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; };
+            friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; };
+            friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; };
+            friend difference_type operator-(const Iterator& a, const Iterator& b) noexcept {
+                return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+            };
+            friend bool operator==(const Iterator& a, const Iterator& b) noexcept { return a.index_ == b.index_; };
+            friend auto operator<=>(const Iterator& a, const Iterator& b) noexcept { return a.index_ <=> b.index_; };
+
+        private:
+            Buffer* buffer_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        // Logical index (0 = head_) -> slot in buff. index < capacity_, so
+        // one subtraction replaces the modulo.
+        size_t physical(size_t index) const noexcept {
+            const size_t slot = head_ + index;
+            return (slot >= capacity_) ? slot - capacity_ : slot;
+        }
+
+        // Full buffer: evict the oldest (Overwrite) or refuse (Reject).
+        template<typename U>
+        bool overwrite(U&& item) {
+            if (policy_ == OverflowPolicy::Reject || capacity_ == 0) {
+                return false;
+            }
+            //tail_ == head_ when full: the new item replaces the oldest
+            buff[tail_] = std::forward<U>(item);
+            tail_ = (tail_ + 1) % capacity_;
+            head_ = tail_;
+            return true;
+        }
+
         const size_t capacity_;
+        const OverflowPolicy policy_;
         std::vector<T> buff;
         size_t currSize_;
         size_t head_;
@@ -0,0 +1,216 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "concurrency/SeqLock.h"
+#include "queues/SlotArray.h"
+#include "queues/SpscRing.h"
+
+/*
+   Design thoughts:
+
+   * One producer, one consumer, latest-value-per-key delivery
+        - If the consumer falls behind, a new update for a key that is still
+        waiting to be read overwrites the waiting value in place instead of
+        queueing behind it (it is "conflated")
+        - So at most one entry per key is ever pending, memory is fixed at
+        construction and a slow consumer always reads the freshest value
+
+    * Layout:
+        - entries_: one cache-line padded Entry per key (key, value, flags)
+        - index_: producer-private open-addressing table key -> entry, O(1)
+        - ready_: an SpscRing<uint32_t> of entry numbers waiting to be read, in
+        the order their key first became pending. Each key is in it at most
+        once, so a ring of max_keys slots can never overflow
+
+    * Overwriting in place while the consumer may be reading:
+        - The value sits in a SeqLock (see SeqLock.h): the consumer copies it
+        out and retries if the producer wrote meanwhile. Hence T must be
+        trivially copyable
+
+    * The pending flag decides whether an update needs a ring entry:
+        - producer: write value, then exchange(pending, 1). Was 0 -> push the
+        entry number; was 1 -> the consumer has not read it yet, conflated
+        - consumer: pop entry number, exchange(pending, 0), then read the value.
+        Both sides use RMWs so that a conflated write is always visible to the
+        read that follows the clear
+        - An update landing between the clear and the read gets enqueued again
+        although the read already saw it. The consumer remembers the version it
+        last delivered per entry and skips such repeats
+
+*/
+
+namespace My {
+
+    template<typename Key, typename T, typename Hash = std::hash<Key>>
+    class ConflationQueue {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "ConflationQueue: T is copied under a seqlock and must be trivially copyable");
+
+    public:
+        // Room for max_keys distinct keys; that is also the most that can be pending.
+        explicit ConflationQueue(size_t max_keys):
+            max_keys_(max_keys),
+            index_mask_(std::bit_ceil(std::max<size_t>(2 * max_keys, 2)) - 1),
+            entries_(max_keys),
+            index_(index_mask_ + 1, kNoEntry),
+            delivered_version_(max_keys, 0),
+            ready_(max_keys)
+        {
+            for (size_t i = 0; i < max_keys_; i++) {
+                entries_.construct(i);
+            }
+        };
+
+        ~ConflationQueue() {
+            for (size_t i = 0; i < used_; i++) {
+                entries_[i].key()->~Key();
+            }
+            for (size_t i = 0; i < max_keys_; i++) {
+                entries_.destroy(i);
+            }
+        };
+
+        // Non-copyable, Non-movable
+        ConflationQueue(const ConflationQueue&) = delete;
+        ConflationQueue& operator=(const ConflationQueue&) = delete;
+        ConflationQueue(ConflationQueue&&) = delete;
+        ConflationQueue& operator=(ConflationQueue&&) = delete;
+
+        // --- Core Operations ---
+
+        // Producer: publishes the latest value for key.
+        // Returns false only if key is new and all max_keys keys are in use.
+        bool push(const Key& key, const T& value) {
+            const uint32_t entry_no = find_or_insert(key);
+            if (entry_no == kNoEntry) {
+                return false;
+            }
+            Entry& entry = entries_[entry_no];
+            entry.value.write(value);
+            pushed_.store(pushed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            if (entry.pending.exchange(1, std::memory_order_acq_rel) == 0) {
+                //Key was not waiting: queue it. Cannot fail, see design notes
+                const bool queued = ready_.push(entry_no);
+                assert(queued && "ConflationQueue - ready ring overflow");
+                (void)queued;
+            }
+            else {
+                //Overwrote a value the consumer has not read yet
+                conflated_.store(conflated_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            return true;
+        };
+
+        // Consumer: takes the oldest pending key with its latest value.
+        // Returns false if nothing is pending.
+        bool pop(Key& key, T& value) {
+            uint32_t entry_no;
+            while (ready_.pop(entry_no)) {
+                Entry& entry = entries_[entry_no];
+                entry.pending.exchange(0, std::memory_order_acq_rel);
+                const uint64_t version = entry.value.read(value);
+                if (version == delivered_version_[entry_no]) {
+                    //Already handed out by the previous pop of this key
+                    continue;
+                }
+                delivered_version_[entry_no] = version;
+                key = *entry.key();
+                delivered_.store(delivered_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        };
+
+        // --- Observers ---
+
+        // Keys currently waiting to be read (snapshot).
+        size_t size() const noexcept {
+            return ready_.size();
+        };
+        bool empty() const noexcept {
+            return ready_.empty();
+        };
+        size_t capacity() const noexcept {
+            return max_keys_;
+        };
+
+        // --- Counters (relaxed, readable from any thread) ---
+
+        // Updates accepted by push()
+        uint64_t pushed() const noexcept {
+            return pushed_.load(std::memory_order_relaxed);
+        };
+        // Updates that overwrote a value before the consumer saw it
+        uint64_t conflated() const noexcept {
+            return conflated_.load(std::memory_order_relaxed);
+        };
+        // Values handed out by pop(). delivered + conflated <= pushed: an update
+        // that was already read through an earlier pop is skipped, not counted
+        uint64_t delivered() const noexcept {
+            return delivered_.load(std::memory_order_relaxed);
+        };
+
+    private:
+        static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+        struct alignas(64) Entry {
+            SeqLock<T> value;                     // written in place, read under the seqlock
+            std::atomic<uint32_t> pending{0};     // 1 while the entry number sits in ready_
+            alignas(Key) std::byte key_storage[sizeof(Key)];
+
+            Key* key() noexcept {
+                return reinterpret_cast<Key*>(key_storage);
+            }
+        };
+
+        // Producer only. Linear probing; returns kNoEntry when out of keys.
+        uint32_t find_or_insert(const Key& key) {
+            size_t bucket = Hash{}(key) & index_mask_;
+            while (true) {
+                const uint32_t entry_no = index_[bucket];
+                if (entry_no == kNoEntry) {
+                    break;
+                }
+                if (*entries_[entry_no].key() == key) {
+                    return entry_no;
+                }
+                bucket = (bucket + 1) & index_mask_;
+            }
+            if (used_ == max_keys_) {
+                return kNoEntry;
+            }
+            //New key: the entry is not reachable by the consumer until it is
+            //pushed onto ready_, which publishes the key with it
+            const uint32_t entry_no = static_cast<uint32_t>(used_++);
+            new (entries_[entry_no].key()) Key(key);
+            index_[bucket] = entry_no;
+            return entry_no;
+        }
+
+        //Read-only after construction
+        alignas(64) const size_t max_keys_;
+        const size_t index_mask_;
+        SlotArray<Entry> entries_;
+
+        //Producer only (the counters are read by anyone)
+        alignas(64) std::vector<uint32_t> index_;
+        size_t used_ = 0;
+        std::atomic<uint64_t> pushed_{0};
+        std::atomic<uint64_t> conflated_{0};
+
+        //Consumer only
+        alignas(64) std::vector<uint64_t> delivered_version_;
+        std::atomic<uint64_t> delivered_{0};
+
+        SpscRing<uint32_t> ready_;
+    };
+}
@@ -0,0 +1,287 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "queues/SlotArray.h"
+
+/*
+   Design thoughts:
+
+   * Any number of producers and consumers, bounded, lock-free (Vyukov's queue)
+
+   * Every cell carries its own sequence number, which says whose turn it is:
+        - seq == pos:      free, the producer that claims position pos may write it
+        - seq == pos + 1:  full, the consumer that claims position pos may read it
+        - after the read the consumer sets seq = pos + capacity, i.e. free for
+        the producer one lap later
+        - Producers race only on enqueue_pos_ (one CAS to claim a position),
+        consumers only on dequeue_pos_; the two sides never touch each other's
+        cursor, and a producer never waits for another producer's copy to finish
+        before claiming the next position
+
+    * Nothing may throw between claiming a position and storing its seq: the
+    cell would never be published (or freed) and every consumer (or producer)
+    would stop at it for good
+        - T's move constructor and move assignment must be noexcept
+        (static_assert): items are moved into cells and out to pop()'s output
+        - a copy (or any construction) that can throw is done into a temporary
+        BEFORE claiming, then moved in; push_bulk of such a T pushes one by
+        one. A throw there leaves the queue untouched
+
+    * The cursors are free-running 64-bit counters on their own cache lines, the
+    capacity is a power of two (slot = pos & mask)
+
+    * Bulk variants claim a run of ready cells with ONE CAS on the cursor. Each
+    cell is still published with its own release store: consumers pick cells
+    up one at a time, so there is nothing to gain by publishing them together
+
+    * Same surface as SpscRing: push/pop return false when full/empty, the bulk
+    calls return how many items they moved
+
+*/
+
+namespace My {
+
+    template<typename T>
+    class MpmcQueue {
+        static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                      "MpmcQueue: a throw after claiming a cell would wedge the queue; T's moves must be noexcept");
+
+    public:
+        // Capacity is rounded up to a power of two (and at least 2).
+        explicit MpmcQueue(size_t size, SlotMemory memory = SlotMemory::Heap):
+            capacity_(std::bit_ceil(std::max<size_t>(size, 2))),
+            mask_(capacity_ - 1),
+            cells_(capacity_, memory),
+            enqueue_pos_(0),
+            dequeue_pos_(0)
+        {
+            for (size_t i = 0; i < capacity_; i++) {
+                cells_.construct(i, i);
+            }
+        };
+
+        // Single-threaded by now: destroy whatever was pushed but never popped.
+        ~MpmcQueue() {
+            const uint64_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+            for (uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+                Cell& cell = cells_[pos & mask_];
+                if (cell.seq.load(std::memory_order_relaxed) == pos + 1) {
+                    cell.item()->~T();
+                }
+            }
+            for (size_t i = 0; i < capacity_; i++) {
+                cells_.destroy(i);
+            }
+        };
+
+        // Non-copyable, Non-movable
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+        MpmcQueue(MpmcQueue&&) = delete;
+        MpmcQueue& operator=(MpmcQueue&&) = delete;
+
+        // --- Core Operations ---
+
+        // Returns true if successful, false if full.
+        bool push(const T& item) {
+            return emplace(item);
+        };
+        bool push(T&& item) {
+            return emplace(std::move(item));
+        };
+
+        // Returns true if successful, false if empty.
+        bool pop(T& output) {
+            uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells_[pos & mask_];
+                const uint64_t seq = cell->seq.load(std::memory_order_acquire);
+                const int64_t diff = static_cast<int64_t>(seq - (pos + 1));
+                if (diff == 0) {
+                    //Full cell for our position: try to claim it
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    //Producer for this position has not published yet: empty
+                    return false;
+                }
+                else {
+                    //Another consumer took it, catch up
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            take(*cell, pos, output);
+            return true;
+        };
+
+        // --- Batch Operations ---
+
+        // Pushes up to count items. Returns how many were pushed (0 if full).
+        size_t push_bulk(const T* items, size_t count) {
+            if (count == 0) {
+                return 0;
+            }
+            if constexpr (!std::is_nothrow_copy_constructible_v<T>) {
+                //The copies cannot be made in the claimed cells (see above)
+                size_t pushed = 0;
+                while (pushed < count && push(items[pushed])) {
+                    pushed++;
+                }
+                return pushed;
+            }
+            uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            size_t n;
+            while (true) {
+                n = ready_run(pos, 0, count);
+                if (n == 0) {
+                    //First cell not free: either full, or our pos is stale and we reload
+                    const uint64_t seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+                    if (static_cast<int64_t>(seq - pos) < 0) {
+                        return 0;
+                    }
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            for (size_t i = 0; i < n; i++) {
+                Cell& cell = cells_[(pos + i) & mask_];
+                new (cell.item()) T(items[i]);
+                cell.seq.store(pos + i + 1, std::memory_order_release);
+            }
+            return n;
+        };
+
+        // Pops up to count items. Returns how many were popped (0 if empty).
+        size_t pop_bulk(T* output, size_t count) {
+            if (count == 0) {
+                return 0;
+            }
+            uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            size_t n;
+            while (true) {
+                n = ready_run(pos, 1, count);
+                if (n == 0) {
+                    const uint64_t seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+                    if (static_cast<int64_t>(seq - (pos + 1)) < 0) {
+                        return 0;
+                    }
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            for (size_t i = 0; i < n; i++) {
+                take(cells_[(pos + i) & mask_], pos + i, output[i]);
+            }
+            return n;
+        };
+
+        // --- Observers ---
+        // Snapshots only: other threads may move the cursors at any time.
+
+        size_t size() const noexcept {
+            const uint64_t head = dequeue_pos_.load(std::memory_order_acquire);
+            const uint64_t tail = enqueue_pos_.load(std::memory_order_acquire);
+            //A claimed-but-unfinished pop can put head past our stale tail
+            return (tail > head) ? static_cast<size_t>(tail - head) : 0;
+        };
+        bool empty() const noexcept {
+            return size() == 0;
+        };
+        bool full() const noexcept {
+            return size() >= capacity_;
+        };
+        size_t capacity() const noexcept {
+            return capacity_;
+        };
+
+    private:
+        struct Cell {
+            std::atomic<uint64_t> seq;
+            alignas(T) std::byte storage[sizeof(T)];
+
+            explicit Cell(uint64_t initial): seq(initial) {};
+
+            T* item() noexcept {
+                return reinterpret_cast<T*>(storage);
+            }
+        };
+
+        template<typename U>
+        bool emplace(U&& item) {
+            if constexpr (!std::is_nothrow_constructible_v<T, U&&>) {
+                //May throw: build it before claiming a cell (see above)
+                return emplace(T(std::forward<U>(item)));
+            }
+            uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells_[pos & mask_];
+                const uint64_t seq = cell->seq.load(std::memory_order_acquire);
+                const int64_t diff = static_cast<int64_t>(seq - pos);
+                if (diff == 0) {
+                    //Free cell for our position: try to claim it
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    //Consumer one lap behind has not freed it yet: full
+                    return false;
+                }
+                else {
+                    //Another producer took it, catch up
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            new (cell->item()) T(std::forward<U>(item));
+            //Release to ensure pop sees the item
+            cell->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Moves the item out of a claimed cell and hands the cell to the
+        // producer one lap ahead.
+        void take(Cell& cell, uint64_t pos, T& output) {
+            T* item = cell.item();
+            output = std::move(*item);
+            item->~T();
+            //Release to ensure the next producer sees the slot empty
+            cell.seq.store(pos + capacity_, std::memory_order_release);
+        }
+
+        // How many consecutive cells from pos (up to count) are ready?
+        // offset is 0 for producers (seq == pos) and 1 for consumers (seq == pos + 1).
+        size_t ready_run(uint64_t pos, uint64_t offset, size_t count) const {
+            const size_t limit = std::min(count, capacity_);
+            size_t n = 0;
+            while (n < limit &&
+                   cells_[(pos + n) & mask_].seq.load(std::memory_order_acquire) == pos + n + offset) {
+                n++;
+            }
+            return n;
+        }
+
+        //Read-only after construction
+        alignas(64) const size_t capacity_;
+        const size_t mask_;
+        SlotArray<Cell> cells_;
+        //Each cursor on its own line: producers and consumers never share one
+        alignas(64) std::atomic<uint64_t> enqueue_pos_;
+        alignas(64) std::atomic<uint64_t> dequeue_pos_;
+    };
+}
@@ -0,0 +1,413 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+   Design thoughts:
+
+   * SpscRing semantics between two PROCESSES: the header (indices, capacity,
+   version, magic) and the slots live in one shared mapping, so a message
+   crosses with one memcpy in and one out and no syscall on the data path
+
+    * Everything in the mapping must mean the same thing in both processes:
+        - no pointers, only offsets
+        - T trivially copyable (no vtables, no heap pointers, no destructors)
+        - the atomics must be lock-free, otherwise they may be backed by a
+        process-local lock
+        - magic, layout version and sizeof/alignof(T) are checked on attach
+
+    * Each process keeps its own copy of the read-only configuration and of
+    its cached opposite index in the handle, so the hot path only touches the
+    shared head/tail lines (same caching rule as SpscRing)
+
+    * Creation: create() (named, shm_open) or create_anonymous() (memfd, to
+    share with fork()ed children). The creator writes the header and stores
+    the magic LAST with release; attach() refuses a segment whose magic is
+    not there yet
+
+    * Roles and dying peers:
+        - claim(ShmRole) records our pid as producer or consumer. A role held
+        by a live process cannot be claimed; a role held by a dead one can
+        (take-over after a crash)
+        - peer_alive() tells the survivor whether the other side is still there
+        - liveness is kill(pid, 0): if the holder died and the OS gave its pid
+        to an unrelated process, the role still looks held (false "alive")
+        until that process exits too. No pid-reuse protection (start time,
+        pidfd) is attempted
+        - A producer that dies mid-write never advanced tail, so the half
+        written slot is invisible. A consumer that dies mid-pop never advanced
+        head, so its replacement sees that message again (at-least-once)
+
+*/
+
+namespace My {
+
+    enum class ShmRole { Producer, Consumer };
+
+    // Lives at offset 0 of the shared mapping. Offsets only, no pointers.
+    struct alignas(64) ShmRingHeader {
+        static constexpr uint64_t kMagic = 0x31305253504D5953ull; // "SYMPSR01"
+        static constexpr uint32_t kLayoutVersion = 1;
+
+        std::atomic<uint64_t> magic;
+        uint32_t layout_version;
+        uint32_t elem_size;
+        uint32_t elem_align;
+        uint64_t capacity;
+        uint64_t slots_offset;
+        uint64_t total_bytes;
+        std::atomic<int32_t> producer_pid;
+        std::atomic<int32_t> consumer_pid;
+        //Same split as SpscRing: each index on its own line
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+
+    template<typename T>
+    class ShmSpscRing {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "ShmSpscRing: T crosses a process boundary and must be trivially copyable");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int32_t>::is_always_lock_free,
+                      "ShmSpscRing: shared-memory atomics must be lock-free");
+
+    public:
+        // --- Create / Attach ---
+
+        // Creates a named segment (fails if it already exists). Capacity is
+        // rounded up to a power of two. The name is removed by remove().
+        static ShmSpscRing create(const std::string& name, size_t size) {
+            const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "ShmSpscRing::create - shm_open " + name);
+            }
+            try {
+                return initialise(fd, size);
+            }
+            catch (...) {
+                //The name exists now: leave it and every later create() fails with EEXIST
+                shm_unlink(name.c_str());
+                throw;
+            }
+        };
+
+        // Creates an unnamed segment. The mapping survives fork(), which is
+        // how it is shared.
+        static ShmSpscRing create_anonymous(size_t size) {
+#if defined(__linux__)
+            const int fd = memfd_create("ShmSpscRing", MFD_CLOEXEC);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "ShmSpscRing::create_anonymous - memfd_create");
+            }
+            return initialise(fd, size);
+#else
+            const std::string name = "/ShmSpscRing." + std::to_string(getpid());
+            ShmSpscRing ring = create(name, size);
+            shm_unlink(name.c_str());
+            return ring;
+#endif
+        };
+
+        // Maps an existing named segment and checks it was made for this T.
+        static ShmSpscRing attach(const std::string& name) {
+            const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "ShmSpscRing::attach - shm_open " + name);
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+                close(fd);
+                throw std::runtime_error("ShmSpscRing::attach - segment too small: " + name);
+            }
+            ShmSpscRing ring(fd, static_cast<size_t>(st.st_size));
+            ring.validate();
+            ring.load_config();
+            return ring;
+        };
+
+        // Removes a named segment. Existing mappings stay valid.
+        static void remove(const std::string& name) {
+            shm_unlink(name.c_str());
+        };
+
+        ~ShmSpscRing() {
+            if (header_ == nullptr) {
+                return;
+            }
+            release_role();
+            munmap(header_, bytes_);
+            close(fd_);
+        };
+
+        // Owns a mapping: Movable, not copyable
+        ShmSpscRing(const ShmSpscRing&) = delete;
+        ShmSpscRing& operator=(const ShmSpscRing&) = delete;
+        ShmSpscRing(ShmSpscRing&& other) noexcept:
+            fd_(std::exchange(other.fd_, -1)),
+            bytes_(std::exchange(other.bytes_, 0)),
+            header_(std::exchange(other.header_, nullptr)),
+            slots_(std::exchange(other.slots_, nullptr)),
+            capacity_(other.capacity_),
+            mask_(other.mask_),
+            role_claimed_(std::exchange(other.role_claimed_, false)),
+            role_(other.role_),
+            head_cache_(other.head_cache_),
+            tail_cache_(other.tail_cache_)
+        {};
+        ShmSpscRing& operator=(ShmSpscRing&&) = delete;
+
+        // --- Roles ---
+
+        // Records this process as producer or consumer. Throws if a live
+        // process (this one included) already holds the role; takes it over
+        // from a dead one.
+        void claim(ShmRole role) {
+            std::atomic<int32_t>& slot = role_pid(role);
+            const int32_t me = static_cast<int32_t>(getpid());
+            int32_t holder = slot.load(std::memory_order_acquire);
+            while (true) {
+                if (holder != 0 && process_alive(holder)) {
+                    throw std::runtime_error("ShmSpscRing::claim - role held by live pid " + std::to_string(holder));
+                }
+                if (slot.compare_exchange_weak(holder, me, std::memory_order_acq_rel)) {
+                    break;
+                }
+            }
+            role_claimed_ = true;
+            role_ = role;
+            //Start from the shared indices, not whatever a previous holder cached
+            head_cache_ = header_->head.load(std::memory_order_acquire);
+            tail_cache_ = header_->tail.load(std::memory_order_acquire);
+        };
+
+        // Is the process holding the other role still running?
+        // False if nobody holds it (never claimed, exited, or crashed).
+        bool peer_alive() const {
+            const ShmRole other = (role_ == ShmRole::Producer) ? ShmRole::Consumer : ShmRole::Producer;
+            const int32_t pid = role_pid(other).load(std::memory_order_acquire);
+            return pid != 0 && process_alive(pid);
+        };
+
+        // --- Core Operations (same contract as SpscRing) ---
+
+        // Producer. Returns true if successful, false if full.
+        bool push(const T& item) noexcept {
+            const uint64_t curr_tail = header_->tail.load(std::memory_order_relaxed);
+            if (curr_tail - head_cache_ >= capacity_) {
+                head_cache_ = header_->head.load(std::memory_order_acquire);
+                if (curr_tail - head_cache_ >= capacity_) {
+                    return false;
+                }
+            }
+            std::memcpy(slots_ + (curr_tail & mask_), &item, sizeof(T));
+            header_->tail.store(curr_tail + 1, std::memory_order_release);
+            return true;
+        };
+
+        // Consumer. Returns true if successful, false if empty.
+        bool pop(T& output) noexcept {
+            const uint64_t curr_head = header_->head.load(std::memory_order_relaxed);
+            if (curr_head == tail_cache_) {
+                tail_cache_ = header_->tail.load(std::memory_order_acquire);
+                if (curr_head == tail_cache_) {
+                    return false;
+                }
+            }
+            std::memcpy(&output, slots_ + (curr_head & mask_), sizeof(T));
+            header_->head.store(curr_head + 1, std::memory_order_release);
+            return true;
+        };
+
+        // Producer. Pushes up to count items with one release store.
+        size_t push_bulk(const T* items, size_t count) noexcept {
+            //Nothing to copy (the pointer may be null) and nothing to publish
+            if (count == 0) {
+                return 0;
+            }
+            const uint64_t curr_tail = header_->tail.load(std::memory_order_relaxed);
+            size_t free = capacity_ - static_cast<size_t>(curr_tail - head_cache_);
+            if (free < count) {
+                head_cache_ = header_->head.load(std::memory_order_acquire);
+                free = capacity_ - static_cast<size_t>(curr_tail - head_cache_);
+            }
+            const size_t n = std::min(count, free);
+            if (n == 0) {
+                return 0;
+            }
+            const size_t start = curr_tail & mask_;
+            const size_t first = std::min(n, capacity_ - start);
+            std::memcpy(slots_ + start, items, first * sizeof(T));
+            if (n > first) {
+                std::memcpy(slots_, items + first, (n - first) * sizeof(T));
+            }
+            header_->tail.store(curr_tail + n, std::memory_order_release);
+            return n;
+        };
+
+        // Consumer. Pops up to count items with one release store.
+        size_t pop_bulk(T* output, size_t count) noexcept {
+            if (count == 0) {
+                return 0;
+            }
+            const uint64_t curr_head = header_->head.load(std::memory_order_relaxed);
+            size_t used = static_cast<size_t>(tail_cache_ - curr_head);
+            if (used < count) {
+                tail_cache_ = header_->tail.load(std::memory_order_acquire);
+                used = static_cast<size_t>(tail_cache_ - curr_head);
+            }
+            const size_t n = std::min(count, used);
+            if (n == 0) {
+                return 0;
+            }
+            const size_t start = curr_head & mask_;
+            const size_t first = std::min(n, capacity_ - start);
+            std::memcpy(output, slots_ + start, first * sizeof(T));
+            if (n > first) {
+                std::memcpy(output + first, slots_, (n - first) * sizeof(T));
+            }
+            header_->head.store(curr_head + n, std::memory_order_release);
+            return n;
+        };
+
+        // --- Observers ---
+
+        size_t size() const noexcept {
+            const uint64_t curr_head = header_->head.load(std::memory_order_acquire);
+            const uint64_t curr_tail = header_->tail.load(std::memory_order_acquire);
+            return static_cast<size_t>(curr_tail - curr_head);
+        };
+        bool empty() const noexcept {
+            return size() == 0;
+        };
+        bool full() const noexcept {
+            return size() == capacity_;
+        };
+        size_t capacity() const noexcept {
+            return capacity_;
+        };
+        // For passing an anonymous segment to an exec()ed process.
+        int fd() const noexcept {
+            return fd_;
+        };
+
+    private:
+        ShmSpscRing(int fd, size_t bytes):
+            fd_(fd),
+            bytes_(bytes)
+        {
+            void* p = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (p == MAP_FAILED) {
+                const int err = errno;
+                close(fd_);
+                header_ = nullptr;
+                throw std::system_error(err, std::generic_category(), "ShmSpscRing - mmap");
+            }
+            header_ = static_cast<ShmRingHeader*>(p);
+        };
+
+        static constexpr size_t round_up(size_t value, size_t to) noexcept {
+            return (value + to - 1) / to * to;
+        }
+
+        static ShmSpscRing initialise(int fd, size_t size) {
+            const size_t capacity = std::bit_ceil(std::max<size_t>(size, 1));
+            const size_t slots_offset = round_up(sizeof(ShmRingHeader), std::max<size_t>(64, alignof(T)));
+            const size_t bytes = slots_offset + capacity * sizeof(T);
+            if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+                const int err = errno;
+                close(fd);
+                throw std::system_error(err, std::generic_category(), "ShmSpscRing - ftruncate");
+            }
+
+            ShmSpscRing ring(fd, bytes);
+            ShmRingHeader* h = new (ring.header_) ShmRingHeader;
+            h->layout_version = ShmRingHeader::kLayoutVersion;
+            h->elem_size = sizeof(T);
+            h->elem_align = alignof(T);
+            h->capacity = capacity;
+            h->slots_offset = slots_offset;
+            h->total_bytes = bytes;
+            h->producer_pid.store(0, std::memory_order_relaxed);
+            h->consumer_pid.store(0, std::memory_order_relaxed);
+            h->head.store(0, std::memory_order_relaxed);
+            h->tail.store(0, std::memory_order_relaxed);
+            //Magic last: attach() treats a segment without it as not ready
+            h->magic.store(ShmRingHeader::kMagic, std::memory_order_release);
+
+            ring.load_config();
+            return ring;
+        }
+
+        void validate() const {
+            if (header_->magic.load(std::memory_order_acquire) != ShmRingHeader::kMagic) {
+                throw std::runtime_error("ShmSpscRing::attach - bad magic (not a ring, or not initialised yet)");
+            }
+            if (header_->layout_version != ShmRingHeader::kLayoutVersion) {
+                throw std::runtime_error("ShmSpscRing::attach - layout version mismatch");
+            }
+            if (header_->elem_size != sizeof(T) || header_->elem_align != alignof(T)) {
+                throw std::runtime_error("ShmSpscRing::attach - segment was created for a different T");
+            }
+            if (!std::has_single_bit(header_->capacity) || header_->total_bytes > bytes_ ||
+                header_->slots_offset + header_->capacity * sizeof(T) > bytes_) {
+                throw std::runtime_error("ShmSpscRing::attach - corrupt header");
+            }
+        }
+
+        // Copies the read-only configuration into the handle.
+        void load_config() noexcept {
+            capacity_ = static_cast<size_t>(header_->capacity);
+            mask_ = capacity_ - 1;
+            slots_ = reinterpret_cast<T*>(reinterpret_cast<std::byte*>(header_) + header_->slots_offset);
+            head_cache_ = header_->head.load(std::memory_order_acquire);
+            tail_cache_ = header_->tail.load(std::memory_order_acquire);
+        }
+
+        std::atomic<int32_t>& role_pid(ShmRole role) const noexcept {
+            return (role == ShmRole::Producer) ? header_->producer_pid : header_->consumer_pid;
+        }
+
+        void release_role() noexcept {
+            if (!role_claimed_) {
+                return;
+            }
+            int32_t me = static_cast<int32_t>(getpid());
+            //Only if it is still ours (a fork()ed copy of the handle is not the holder)
+            role_pid(role_).compare_exchange_strong(me, 0, std::memory_order_acq_rel);
+            role_claimed_ = false;
+        }
+
+        // Limitation: a reused pid reads as alive (see the design notes).
+        static bool process_alive(int32_t pid) noexcept {
+            return kill(pid, 0) == 0 || errno == EPERM;
+        }
+
+        int fd_ = -1;
+        size_t bytes_ = 0;
+        ShmRingHeader* header_ = nullptr;
+        T* slots_ = nullptr;
+        size_t capacity_ = 0;
+        size_t mask_ = 0;
+        bool role_claimed_ = false;
+        ShmRole role_ = ShmRole::Producer;
+        //Process-private cached views of the other side's index
+        uint64_t head_cache_ = 0;
+        uint64_t tail_cache_ = 0;
+    };
+}
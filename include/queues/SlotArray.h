@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/*
+   Design thoughts:
+
+   * Raw, cache-line aligned storage for the slots of a ring
+        - std::vector<T> needs a default-constructible T (resize) and puts its
+        header next to whatever members follow it
+        - Here the slots are uninitialised memory: the owner constructs an
+        element when it is pushed and destroys it when it is popped, so T only
+        needs to be movable
+
+    * The slot block starts and ends on a full cache line of padding, so no
+    other object (allocator metadata, a neighbouring heap block) ever shares a
+    line with the first or last slot
+
+    * SlotArray does NOT know which slots are live. Destroying the live
+    elements before the storage goes away is the owner's job
+
+    * Huge pages (optional, Linux only):
+        - A big ring spread over 4K pages burns TLB entries; one 2MB page covers it
+        - We try an explicit MAP_HUGETLB mapping first (needs a reserved pool),
+        then fall back to a normal mapping with MADV_HUGEPAGE (transparent huge
+        pages), then to the heap
+        - huge_pages() reports whether the explicit mapping succeeded
+
+*/
+
+namespace My {
+
+    enum class SlotMemory {
+        Heap,       // aligned operator new
+        HugePages   // mmap, huge pages when the system allows it
+    };
+
+    inline constexpr size_t kCacheLine = 64;
+
+    template<typename T>
+    class SlotArray {
+    public:
+        explicit SlotArray(size_t count, SlotMemory memory = SlotMemory::Heap):
+            count_(count)
+        {
+            bytes_ = round_up(count * sizeof(T), kCacheLine) + 2 * kPadding;
+            if (memory == SlotMemory::HugePages) {
+                base_ = map_pages(bytes_);
+            }
+            if (base_ == nullptr) {
+                base_ = ::operator new(bytes_, std::align_val_t{kAlign});
+            }
+            slots_ = reinterpret_cast<T*>(static_cast<std::byte*>(base_) + kPadding);
+        };
+
+        ~SlotArray() {
+            release();
+        };
+
+        // Owns raw memory: Non-copyable, Non-movable
+        SlotArray(const SlotArray&) = delete;
+        SlotArray& operator=(const SlotArray&) = delete;
+        SlotArray(SlotArray&&) = delete;
+        SlotArray& operator=(SlotArray&&) = delete;
+
+        // --- Element lifetime ---
+
+        template<typename... Args>
+        T& construct(size_t index, Args&&... args) {
+            assert(index < count_ && "SlotArray::construct - Index out of range");
+            return *new (slots_ + index) T(std::forward<Args>(args)...);
+        };
+
+        void destroy(size_t index) noexcept {
+            assert(index < count_ && "SlotArray::destroy - Index out of range");
+            slots_[index].~T();
+        };
+
+        // --- Accessors ---
+
+        T& operator[](size_t index) noexcept {
+            assert(index < count_);
+            return slots_[index];
+        };
+        const T& operator[](size_t index) const noexcept {
+            assert(index < count_);
+            return slots_[index];
+        };
+
+        T* data() noexcept { return slots_; };
+        const T* data() const noexcept { return slots_; };
+        size_t size() const noexcept { return count_; };
+        bool huge_pages() const noexcept { return mapping_ == Mapping::HugeTlb; };
+
+    private:
+        // Big enough to keep neighbours off our lines, and to keep the first
+        // slot aligned for over-aligned T
+        static constexpr size_t kAlign = std::max(kCacheLine, alignof(T));
+        static constexpr size_t kPadding = kAlign;
+        static constexpr size_t kHugePage = size_t(2) << 20;
+
+        enum class Mapping { None, HugeTlb, Transparent };
+
+        static constexpr size_t round_up(size_t value, size_t to) noexcept {
+            return (value + to - 1) / to * to;
+        }
+
+        // Returns nullptr if no mapping could be made; the caller uses the heap.
+        void* map_pages(size_t& bytes) {
+#if defined(__linux__)
+            const size_t huge_bytes = round_up(bytes, kHugePage);
+            void* p = mmap(nullptr, huge_bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                bytes = huge_bytes;
+                mapping_ = Mapping::HugeTlb;
+                return p;
+            }
+            p = mmap(nullptr, huge_bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p != MAP_FAILED) {
+                //Best effort: fine if THP is disabled
+                madvise(p, huge_bytes, MADV_HUGEPAGE);
+                bytes = huge_bytes;
+                mapping_ = Mapping::Transparent;
+                return p;
+            }
+#else
+            (void)bytes;
+#endif
+            return nullptr;
+        }
+
+        void release() noexcept {
+            if (base_ == nullptr) {
+                return;
+            }
+#if defined(__linux__)
+            if (mapping_ != Mapping::None) {
+                munmap(base_, bytes_);
+                base_ = nullptr;
+                return;
+            }
+#endif
+            ::operator delete(base_, std::align_val_t{kAlign});
+            base_ = nullptr;
+        }
+
+        const size_t count_;
+        size_t bytes_ = 0;
+        void* base_ = nullptr;
+        T* slots_ = nullptr;
+        Mapping mapping_ = Mapping::None;
+    };
+}
@@ -1,7 +1,18 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <span>
+#include <type_traits>
+
+#include "concurrency/Backoff.h"
+#include "queues/SlotArray.h"
 
 /*
    Design thoughts:
@@ -19,25 +30,88 @@
         - As well as ensuring the tail is incremented atomically
         - This is overly restrictive, but we start here
 
+    * Cached opposite index:
+        - Every acquire load of the other thread's index pulls its cache line
+        over to our core, so at high rates head_/tail_ bounce constantly
+        - The producer keeps a private copy of head_ (head_cache_) and the
+        consumer a private copy of tail_ (tail_cache_)
+        - We only re-read the shared atomic when the cached view says full/empty,
+        which is once per "lap" of the other thread rather than once per message
+        - Each cache sits on the line of the thread that owns it, so it never
+        causes sharing itself
+
+    * Batching:
+        - push_bulk/pop_bulk move up to n items with ONE release store, so a
+        burst pays for synchronisation once instead of once per element
+        - The live region wraps at most once, so a batch is at most two
+        contiguous ranges; trivially copyable T goes through memcpy
+        - try_reserve/commit hands the producer the slots themselves so it can
+        build messages in place (zero-copy)
+
+    * Free-running 64-bit sequences:
+        - head_/tail_ count every pop/push ever done and are never wrapped, so
+        size is tail - head and full is size == capacity (no sacrificial slot)
+        - A uint64_t will not overflow at any realistic message rate
+        - The slot is seq % capacity, or seq & mask when the ring is built with
+        RingCapacity::PowerOfTwo, which takes the division off the hot path
+
+    * Blocking layer (push_wait/pop_wait):
+        - Built on top of push/pop: spin -> yield (see Backoff.h), then park with
+        std::atomic::wait on the index the other side will move
+        - A parking thread raises a flag first; the other side's *_wait call only
+        pays for notify when that flag is up
+        - Flag + index form a Dekker pair (each side writes one, reads the
+        other), hence a seq_cst fence on both sides. Plain push/pop never touch
+        the flags, so the non-blocking path costs exactly what it did
+        - Consequence: a parked consumer is only woken by push_wait (and a parked
+        producer only by pop_wait). Use the *_wait calls on both sides
+        - The *_wait_for versions never park (atomic::wait has no timeout); they
+        sleep in growing steps once spinning and yielding are used up
+
+    * Slot storage (see SlotArray.h):
+        - Slots are raw, cache-line aligned memory (optionally huge pages), not
+        a std::vector. push constructs in place and pop destroys, so T does not
+        need a default constructor
+        - The read-only configuration (capacity, mask, wait policy, slot
+        pointer) gets a cache line of its own, so the index writes below never
+        invalidate it
+        - try_reserve hands out slots that were never constructed, so it is only
+        offered for trivially copyable T
+
 */
 
 namespace My {
 
-    template<typename T>
+    // How the ring maps a sequence number onto a slot.
+    enum class RingCapacity {
+        Exact,      // capacity as requested, slot = seq % capacity
+        PowerOfTwo  // capacity rounded up to a power of two, slot = seq & mask
+    };
+
+    template<typename T, RingCapacity Mode = RingCapacity::Exact>
     class SpscRing {
     public:
         // Allocates the buffer of given size.
-        explicit SpscRing(size_t size):
-            capacity_(size+1),
-            size_(size),
+        // In PowerOfTwo mode the size is rounded up to the next power of two.
+        explicit SpscRing(size_t size, WaitPolicy wait_policy = {},
+                          SlotMemory memory = SlotMemory::Heap):
+            capacity_(Mode == RingCapacity::PowerOfTwo ? std::bit_ceil(size) : size),
+            mask_(capacity_ - 1),
+            wait_policy_(wait_policy),
+            slots_(capacity_, memory),
             head_(0),
-            tail_(0)
-        {
-            //We need a sacraficial slot to determine empty/full
-            buff_.resize(capacity_);
-        };
+            tail_cache_(0),
+            tail_(0),
+            head_cache_(0)
+        {};
 
-        ~SpscRing() = default;
+        // Destroys whatever was pushed but never popped.
+        ~SpscRing() {
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            for (uint64_t seq = head_.load(std::memory_order_relaxed); seq != curr_tail; ++seq) {
+                slots_.destroy(slot(seq));
+            }
+        };
 
         // Non-copyable, Non-movable
         SpscRing(const SpscRing&) = delete;
@@ -49,51 +123,183 @@ namespace My {
 
         // Returns true if successful, false if full.
         bool push(const T& item) {
-            const size_t curr_tail = tail_.load(std::memory_order_relaxed);
-            const size_t next_tail = (curr_tail + 1) % capacity_;
-            //Producer therefore we must acquire head (ensure we are sync'd with pop)
-            if ( next_tail != head_.load(std::memory_order_acquire)) {
-                //If head not directly in front of tail, we can push
-                buff_[curr_tail] = item;
-                //Release to ensure pop can get it
-                tail_.store(next_tail, std::memory_order_release);
-                return true;
-            }
-            else {
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            if (!has_space(curr_tail)) {
                 return false;
             }
+            slots_.construct(slot(curr_tail), item);
+            //Release to ensure pop can get it
+            tail_.store(curr_tail + 1, std::memory_order_release);
+            return true;
         };
-        bool push(T&& item) {;
-            const size_t curr_tail = tail_.load(std::memory_order_relaxed);
-            const size_t next_tail = (curr_tail + 1) % capacity_;
-            //Producer therefore we must acquire head (ensure we are sync'd with pop)
-            if ( next_tail != head_.load(std::memory_order_acquire)) {
-                //If head not directly in front of tail, we can push
-                buff_[curr_tail] = std::move(item);
-                //Release to ensure pop can get it
-                tail_.store(next_tail, std::memory_order_release);
-                return true;
-            }
-            else {
+        bool push(T&& item) {
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            if (!has_space(curr_tail)) {
                 return false;
             }
+            slots_.construct(slot(curr_tail), std::move(item));
+            //Release to ensure pop can get it
+            tail_.store(curr_tail + 1, std::memory_order_release);
+            return true;
         };
 
         // Returns true if successful, false if empty.
         bool pop(T& output) {
             //Pop owns head so we can do this relaxed
-            const size_t curr_head = head_.load(std::memory_order_relaxed);
-            //Acquire tail_ to ensure syncd with push()
-            if (curr_head != tail_.load(std::memory_order_acquire)) {
-                output = std::move(buff_[curr_head]);
-                //Release to ensure push() can get it
-                head_.store((curr_head + 1) % capacity_, std::memory_order_release);
-                return true;
-            }
-            else {
+            const uint64_t curr_head = head_.load(std::memory_order_relaxed);
+            if (!has_data(curr_head)) {
                 return false;
             }
+            const size_t index = slot(curr_head);
+            output = std::move(slots_[index]);
+            slots_.destroy(index);
+            //Release to ensure push() can get it
+            head_.store(curr_head + 1, std::memory_order_release);
+            return true;
+        };
+
+        // --- Batch Operations ---
+
+        // Pushes up to count items from items[0..count).
+        // Returns how many were pushed (0 if full). One release store per call.
+        size_t push_bulk(const T* items, size_t count) {
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            const size_t n = std::min(count, free_slots(curr_tail, count));
+            if (n == 0) {
+                return 0;
+            }
+            //At most two ranges: up to the end of the buffer, then from the start
+            const size_t start = slot(curr_tail);
+            const size_t first = std::min(n, capacity_ - start);
+            copy_range(items, first, slots_.data() + start);
+            try {
+                copy_range(items + first, n - first, slots_.data());
+            }
+            catch (...) {
+                //Nothing was published: the first range is ours to destroy
+                std::destroy_n(slots_.data() + start, first);
+                throw;
+            }
+            //Release to ensure pop can get the whole batch
+            tail_.store(curr_tail + n, std::memory_order_release);
+            return n;
+        };
+
+        // Pops up to count items into output[0..count).
+        // Returns how many were popped (0 if empty). One release store per call.
+        size_t pop_bulk(T* output, size_t count) {
+            const uint64_t curr_head = head_.load(std::memory_order_relaxed);
+            const size_t n = std::min(count, used_slots(curr_head, count));
+            if (n == 0) {
+                return 0;
+            }
+            const size_t start = slot(curr_head);
+            const size_t first = std::min(n, capacity_ - start);
+            move_range(slots_.data() + start, first, output);
+            move_range(slots_.data(), n - first, output + first);
+            //Release to ensure push() can reuse the whole batch
+            head_.store(curr_head + n, std::memory_order_release);
+            return n;
+        };
 
+        // Zero-copy producer path: returns up to count contiguous free slots
+        // starting at the tail (empty if full). The span stops at the end of the
+        // buffer, so it can be shorter than count even when the ring has room.
+        // Write into it, then publish with commit().
+        // Trivially copyable T only: the slots are raw memory until written.
+        std::span<T> try_reserve(size_t count) requires std::is_trivially_copyable_v<T> {
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            const size_t free = free_slots(curr_tail, count);
+            if (free == 0 || count == 0) {
+                reserved_ = 0;
+                return {};
+            }
+            const size_t start = slot(curr_tail);
+            reserved_ = std::min({count, free, capacity_ - start});
+            return std::span<T>(slots_.data() + start, reserved_);
+        };
+
+        // Publishes the first count slots of the last try_reserve() span.
+        void commit(size_t count) requires std::is_trivially_copyable_v<T> {
+            assert(count <= reserved_ && "SpscRing::commit - more than was reserved");
+            reserved_ = 0;
+            if (count == 0) {
+                return;
+            }
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            tail_.store(curr_tail + count, std::memory_order_release);
+        };
+
+        // --- Blocking Operations ---
+
+        // Pushes, waiting for space if the ring is full.
+        void push_wait(const T& item) {
+            Backoff backoff(wait_policy_);
+            while (!push(item)) {
+                if (!backoff.pause()) {
+                    park_producer();
+                }
+            }
+            notify_consumer();
+        };
+        void push_wait(T&& item) {
+            Backoff backoff(wait_policy_);
+            while (!push(std::move(item))) {
+                if (!backoff.pause()) {
+                    park_producer();
+                }
+            }
+            notify_consumer();
+        };
+
+        // Pops, waiting for data if the ring is empty.
+        void pop_wait(T& output) {
+            Backoff backoff(wait_policy_);
+            while (!pop(output)) {
+                if (!backoff.pause()) {
+                    park_consumer();
+                }
+            }
+            notify_producer();
+        };
+
+        // Timed versions: return false if nothing happened before the timeout.
+        // item is left untouched on timeout.
+        template<typename Rep, typename Period>
+        bool push_wait_for(const T& item, std::chrono::duration<Rep, Period> timeout) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            Backoff backoff(wait_policy_);
+            while (!push(item)) {
+                if (!backoff.pause() && !backoff.sleep_until(deadline)) {
+                    return false;
+                }
+            }
+            notify_consumer();
+            return true;
+        };
+        template<typename Rep, typename Period>
+        bool push_wait_for(T&& item, std::chrono::duration<Rep, Period> timeout) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            Backoff backoff(wait_policy_);
+            while (!push(std::move(item))) {
+                if (!backoff.pause() && !backoff.sleep_until(deadline)) {
+                    return false;
+                }
+            }
+            notify_consumer();
+            return true;
+        };
+        template<typename Rep, typename Period>
+        bool pop_wait_for(T& output, std::chrono::duration<Rep, Period> timeout) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            Backoff backoff(wait_policy_);
+            while (!pop(output)) {
+                if (!backoff.pause() && !backoff.sleep_until(deadline)) {
+                    return false;
+                }
+            }
+            notify_producer();
+            return true;
         };
 
         // --- Observers ---
@@ -102,30 +308,157 @@ namespace My {
             return head_ == tail_;
         };
         bool full() const noexcept {
-            return ((tail_ + 1) % capacity_) == head_;
+            return size() == capacity_;
         };
+        // The indices never wrap, so this is a single subtraction.
+        // Load head first: tail only grows, so the result never underflows.
         size_t size() const noexcept {
-            const size_t curr_tail = tail_.load(std::memory_order_relaxed);
-            const size_t curr_head = head_.load(std::memory_order_relaxed);
-
-            if (curr_head > curr_tail) {
-                return (capacity_ - curr_head) + curr_tail;
-            }
-            else {
-                return curr_tail - curr_head;
-            }
+            const uint64_t curr_head = head_.load(std::memory_order_acquire);
+            const uint64_t curr_tail = tail_.load(std::memory_order_acquire);
+            return static_cast<size_t>(curr_tail - curr_head);
         };
         size_t capacity() const noexcept {
-            return size_;
+            return capacity_;
+        };
+        bool huge_pages() const noexcept {
+            return slots_.huge_pages();
         };
 
     private:
-        const size_t capacity_;
-        const size_t size_;
-        std::vector<T> buff_;
+        // Sequence number -> index into slots_
+        size_t slot(uint64_t seq) const noexcept {
+            if constexpr (Mode == RingCapacity::PowerOfTwo) {
+                return static_cast<size_t>(seq & mask_);
+            }
+            else {
+                return static_cast<size_t>(seq % capacity_);
+            }
+        }
+
+        // Producer side: is there room to write at curr_tail?
+        // Only touches the shared head_ when the cached copy says we are full.
+        bool has_space(uint64_t curr_tail) noexcept {
+            if (curr_tail - head_cache_ < capacity_) {
+                return true;
+            }
+            //Producer therefore we must acquire head (ensure we are sync'd with pop)
+            head_cache_ = head_.load(std::memory_order_acquire);
+            return curr_tail - head_cache_ < capacity_;
+        }
+
+        // Consumer side: is there anything at curr_head?
+        // Only touches the shared tail_ when the cached copy says we are empty.
+        bool has_data(uint64_t curr_head) noexcept {
+            if (curr_head != tail_cache_) {
+                return true;
+            }
+            //Acquire tail_ to ensure syncd with push()
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            return curr_head != tail_cache_;
+        }
+
+        // Producer side: sleep until the consumer moves head_ (or a spurious wake).
+        void park_producer() {
+            const uint64_t curr_tail = tail_.load(std::memory_order_relaxed);
+            producer_parked_.store(1, std::memory_order_relaxed);
+            //Pairs with the fence in notify_producer(): either we see the new head or it sees our flag
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint64_t seen_head = head_.load(std::memory_order_relaxed);
+            if (curr_tail - seen_head >= capacity_) {
+                head_.wait(seen_head, std::memory_order_acquire);
+            }
+            producer_parked_.store(0, std::memory_order_relaxed);
+        }
+
+        // Consumer side: sleep until the producer moves tail_ (or a spurious wake).
+        void park_consumer() {
+            const uint64_t curr_head = head_.load(std::memory_order_relaxed);
+            consumer_parked_.store(1, std::memory_order_relaxed);
+            //Pairs with the fence in notify_consumer()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (tail_.load(std::memory_order_relaxed) == curr_head) {
+                tail_.wait(curr_head, std::memory_order_acquire);
+            }
+            consumer_parked_.store(0, std::memory_order_relaxed);
+        }
+
+        // Called after a successful push_wait: wake the consumer only if it parked.
+        void notify_consumer() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumer_parked_.load(std::memory_order_relaxed)) {
+                tail_.notify_one();
+            }
+        }
+
+        // Called after a successful pop_wait: wake the producer only if it parked.
+        void notify_producer() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (producer_parked_.load(std::memory_order_relaxed)) {
+                head_.notify_one();
+            }
+        }
+
+        // Producer side: how many slots are free? Refreshes the cached head only
+        // when the cached view cannot satisfy the request.
+        size_t free_slots(uint64_t curr_tail, size_t wanted) noexcept {
+            size_t free = capacity_ - static_cast<size_t>(curr_tail - head_cache_);
+            if (free < wanted) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                free = capacity_ - static_cast<size_t>(curr_tail - head_cache_);
+            }
+            return free;
+        }
+
+        // Consumer side: how many slots hold data? Same caching rule.
+        size_t used_slots(uint64_t curr_head, size_t wanted) noexcept {
+            size_t used = static_cast<size_t>(tail_cache_ - curr_head);
+            if (used < wanted) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                used = static_cast<size_t>(tail_cache_ - curr_head);
+            }
+            return used;
+        }
+
+        // Bulk copy into (raw) slots: memcpy for trivially copyable T
+        static void copy_range(const T* src, size_t count, T* dst) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (count != 0) {
+                    std::memcpy(dst, src, count * sizeof(T));
+                }
+            }
+            else {
+                std::uninitialized_copy_n(src, count, dst);
+            }
+        }
+
+        // Bulk move out of the ring, leaving the slots raw again
+        static void move_range(T* src, size_t count, T* dst) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (count != 0) {
+                    std::memcpy(dst, src, count * sizeof(T));
+                }
+            }
+            else {
+                std::move(src, src + count, dst);
+                std::destroy_n(src, count);
+            }
+        }
+
+        //Read-only after construction: gets a line to itself (head_ starts the next one)
+        alignas(64) const size_t capacity_;
+        const size_t mask_;
+        const WaitPolicy wait_policy_;
+        SlotArray<T> slots_;
         //To prevent cache contention, you MUST align them
-        alignas(64) std::atomic<int> head_;
-        alignas(64) std::atomic<int> tail_;
+        //Consumer line: head_ plus the consumer's private view of tail_
+        alignas(64) std::atomic<uint64_t> head_;
+        uint64_t tail_cache_;
+        //Producer line: tail_ plus the producer's private view of head_
+        alignas(64) std::atomic<uint64_t> tail_;
+        uint64_t head_cache_;
+        size_t reserved_ = 0;
+        //Parking flags: written only when a side parks, so this line is read-mostly
+        alignas(64) std::atomic<uint32_t> consumer_parked_ = 0;
+        std::atomic<uint32_t> producer_parked_ = 0;
     };
 }
-
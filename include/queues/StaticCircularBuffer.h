@@ -0,0 +1,192 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/*
+   Design thoughts:
+
+   * CircularBuffer with the capacity fixed at compile time, stored inline the
+   way Array<T, N> is: no allocation, and a small ring lives in the cache lines
+   of the object that owns it
+
+    * N must be a power of two: slot = index & (N - 1), no division anywhere
+
+    * Free-running head_/tail_ (the SpscRing trick): size = tail_ - head_, so
+    there is no separate count to keep in sync, and full vs empty is never
+    ambiguous. size_t wrap-around is harmless because N divides 2^64
+
+    * Slots are a union around T, so:
+        - T need not be default-constructible (nothing is built until push)
+        - elements are constructed with std::construct_at and destroyed with
+        std::destroy_at, both usable in constant expressions
+    The whole buffer works inside constexpr functions
+
+*/
+
+namespace My {
+
+    template<typename T, size_t N>
+    class StaticCircularBuffer {
+        static_assert(N > 0 && std::has_single_bit(N), "StaticCircularBuffer: N must be a power of two");
+
+    public:
+        using value_type = T;
+
+        constexpr StaticCircularBuffer() noexcept {};
+
+        constexpr StaticCircularBuffer(const StaticCircularBuffer& other) {
+            construct_from(other);
+        };
+
+        constexpr StaticCircularBuffer(StaticCircularBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            construct_from(std::move(other));
+        };
+
+        constexpr StaticCircularBuffer& operator=(const StaticCircularBuffer& other) {
+            if (this != &other) {
+                clear();
+                for (size_t i = other.head_; i != other.tail_; i++) {
+                    push(other.slots_[i & kMask].value);
+                }
+            }
+            return *this;
+        };
+
+        constexpr StaticCircularBuffer& operator=(StaticCircularBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                for (size_t i = other.head_; i != other.tail_; i++) {
+                    push(std::move(other.slots_[i & kMask].value));
+                }
+            }
+            return *this;
+        };
+
+        constexpr ~StaticCircularBuffer() {
+            clear();
+        };
+
+        // --- Core Operations ---
+
+        // Returns true if successful, false if full.
+        constexpr bool push(const T& item) {
+            return emplace(item);
+        };
+        constexpr bool push(T&& item) {
+            return emplace(std::move(item));
+        };
+
+        template<typename... Args>
+        constexpr bool emplace(Args&&... args) {
+            if (full()) {
+                return false;
+            }
+            std::construct_at(&slots_[tail_ & kMask].value, std::forward<Args>(args)...);
+            tail_++;
+            return true;
+        };
+
+        // Returns true if successful (writes to output), false if empty.
+        constexpr bool pop(T& output) {
+            if (empty()) {
+                return false;
+            }
+            T& item = slots_[head_ & kMask].value;
+            output = std::move(item);
+            std::destroy_at(&item);
+            head_++;
+            return true;
+        };
+
+        // Destroys every element.
+        constexpr void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (size_t i = head_; i != tail_; i++) {
+                    std::destroy_at(&slots_[i & kMask].value);
+                }
+            }
+            head_ = tail_;
+        };
+
+        // --- Element Access (index 0 = oldest) ---
+
+        constexpr T& operator[](size_t index) noexcept {
+            assert(index < size() && "StaticCircularBuffer - Index out of range");
+            return slots_[(head_ + index) & kMask].value;
+        };
+        constexpr const T& operator[](size_t index) const noexcept {
+            assert(index < size() && "StaticCircularBuffer - Index out of range");
+            return slots_[(head_ + index) & kMask].value;
+        };
+        constexpr T& front() noexcept {
+            return (*this)[0];
+        };
+        constexpr const T& front() const noexcept {
+            return (*this)[0];
+        };
+        constexpr T& back() noexcept {
+            return (*this)[size() - 1];
+        };
+        constexpr const T& back() const noexcept {
+            return (*this)[size() - 1];
+        };
+
+        // --- Observers ---
+
+        constexpr bool empty() const noexcept {
+            return head_ == tail_;
+        };
+        constexpr bool full() const noexcept {
+            return tail_ - head_ == N;
+        };
+        constexpr size_t size() const noexcept {
+            return tail_ - head_;
+        };
+        static constexpr size_t capacity() noexcept {
+            return N;
+        };
+
+    private:
+        static constexpr size_t kMask = N - 1;
+
+        // Storage for one T that is not constructed until push.
+        union Slot {
+            constexpr Slot() noexcept {};
+            constexpr ~Slot() requires std::is_trivially_destructible_v<T> = default;
+            constexpr ~Slot() {};
+
+            T value;
+        };
+
+        // Constructors: copies (or moves, for an rvalue) other's elements in
+        // through push(), which advances tail_ per element. A throw destroys
+        // exactly what was built; the destructor does not run for a
+        // constructor that throws.
+        template<typename Other>
+        constexpr void construct_from(Other&& other) {
+            try {
+                for (size_t i = other.head_; i != other.tail_; i++) {
+                    if constexpr (std::is_rvalue_reference_v<Other&&>) {
+                        push(std::move(other.slots_[i & kMask].value));
+                    }
+                    else {
+                        push(other.slots_[i & kMask].value);
+                    }
+                }
+            }
+            catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        Slot slots_[N];
+        size_t head_ = 0;
+        size_t tail_ = 0;
+    };
+}
@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    void top_up_hook();
+}
+#define MY_ATOMIC_SHARED_PTR_TOP_UP_HOOK() top_up_hook()
+#include "memory/AtomicSharedPtr.h"
+
+using namespace My;
+
+namespace {
+
+    //A thread that sets t_stall_here parks in its next top-up until g_resume
+    thread_local bool t_stall_here = false;
+    std::atomic<bool> g_stalled{false};
+    std::atomic<bool> g_resume{false};
+
+    void top_up_hook() {
+        if (!t_stall_here) return;
+        t_stall_here = false;
+        g_stalled.store(true);
+        while (!g_resume.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::atomic<int> g_live{0};
+
+    struct Tracked {
+        explicit Tracked(int v): value(v) { g_live++; }
+        ~Tracked() { g_live--; }
+        Tracked(const Tracked&) = delete;
+        int value;
+    };
+
+}
+
+// --- BASICS ---
+
+TEST(AtomicSharedPtrTest, DefaultIsEmpty) {
+    AtomicSharedPtr<Tracked> a;
+    EXPECT_FALSE(a.load());
+    static_assert(AtomicSharedPtr<Tracked>::is_always_lock_free);
+}
+
+TEST(AtomicSharedPtrTest, LoadSharesOwnership) {
+    {
+        auto p = make_shared<Tracked>(7);
+        AtomicSharedPtr<Tracked> a(p);
+        SharedPtr<Tracked> loaded = a.load();
+        EXPECT_EQ(loaded.get(), p.get());
+        EXPECT_EQ(loaded->value, 7);
+        EXPECT_EQ(g_live, 1);
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST(AtomicSharedPtrTest, LoadOutlivesStore) {
+    AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+    SharedPtr<Tracked> old = a.load();
+    a.store(make_shared<Tracked>(2));
+    EXPECT_EQ(old->value, 1); // Still owned by the reader
+    EXPECT_EQ(a.load()->value, 2);
+    EXPECT_EQ(g_live, 2);
+    old.reset();
+    EXPECT_EQ(g_live, 1);
+}
+
+TEST(AtomicSharedPtrTest, StoreReleasesPrevious) {
+    {
+        AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+        a.load();
+        a.store(make_shared<Tracked>(2));
+        EXPECT_EQ(g_live, 1);
+        a.store(SharedPtr<Tracked>());
+        EXPECT_EQ(g_live, 0);
+        EXPECT_FALSE(a.load());
+        a = SharedPtr<Tracked>(new Tracked(3)); // Separate control block
+        EXPECT_EQ(static_cast<SharedPtr<Tracked>>(a)->value, 3);
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST(AtomicSharedPtrTest, ExchangeReturnsOwningPrevious) {
+    AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+    SharedPtr<Tracked> held = a.load();
+    SharedPtr<Tracked> old = a.exchange(make_shared<Tracked>(2));
+    EXPECT_EQ(old.get(), held.get());
+    held.reset();
+    EXPECT_EQ(old->value, 1);
+    EXPECT_EQ(g_live, 2);
+    old.reset();
+    EXPECT_EQ(g_live, 1);
+}
+
+// --- COMPARE EXCHANGE ---
+
+TEST(AtomicSharedPtrTest, CompareExchangeSucceedsOnSameObject) {
+    AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+    SharedPtr<Tracked> expected = a.load();
+    EXPECT_TRUE(a.compare_exchange_strong(expected, make_shared<Tracked>(2)));
+    EXPECT_EQ(a.load()->value, 2);
+    expected.reset();
+    EXPECT_EQ(g_live, 1);
+}
+
+TEST(AtomicSharedPtrTest, CompareExchangeFailsAndReloads) {
+    AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+    SharedPtr<Tracked> expected = make_shared<Tracked>(1); // Equal value, other object
+    SharedPtr<Tracked> desired = make_shared<Tracked>(2);
+    EXPECT_FALSE(a.compare_exchange_strong(expected, desired));
+    EXPECT_EQ(expected.get(), a.load().get());
+    EXPECT_EQ(a.load()->value, 1);
+    EXPECT_EQ(desired->value, 2); // Untouched on failure
+    EXPECT_EQ(g_live, 2);
+}
+
+TEST(AtomicSharedPtrTest, CompareExchangeFromEmpty) {
+    AtomicSharedPtr<Tracked> a;
+    SharedPtr<Tracked> expected;
+    EXPECT_TRUE(a.compare_exchange_weak(expected, make_shared<Tracked>(5)));
+    EXPECT_EQ(a.load()->value, 5);
+    EXPECT_FALSE(a.compare_exchange_weak(expected, make_shared<Tracked>(6)));
+    EXPECT_EQ(expected->value, 5);
+}
+
+// --- SPLIT COUNT ---
+
+TEST(AtomicSharedPtrTest, ManyLoadsHeldAtOnce) {
+    //Far more than the 16-bit local count: needs the credit top-up
+    {
+        AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+        std::vector<SharedPtr<Tracked>> held;
+        for (int i = 0; i < 200'000; ++i) {
+            held.push_back(a.load());
+        }
+        a.store(make_shared<Tracked>(2));
+        EXPECT_EQ(g_live, 2);
+        held.resize(1);
+        EXPECT_EQ(held[0]->value, 1);
+        held.clear();
+        EXPECT_EQ(g_live, 1);
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST(AtomicSharedPtrTest, LoadsDroppedRightAway) {
+    AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+    for (int i = 0; i < 200'000; ++i) {
+        EXPECT_EQ(a.load()->value, 1);
+    }
+    a.store(SharedPtr<Tracked>());
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST(AtomicSharedPtrTest, UseCountIncludesUnusedCredit) {
+    auto p = make_shared<Tracked>(1);
+    WeakPtr<Tracked> w(p);
+    EXPECT_EQ(p.use_count(), 1);
+    AtomicSharedPtr<Tracked> a(p);
+    //Not 2: the atomic holds credit for future loads (see the design notes)
+    EXPECT_GT(p.use_count(), 2);
+    EXPECT_EQ(w.use_count(), p.use_count());
+    a.store(SharedPtr<Tracked>());
+    EXPECT_EQ(p.use_count(), 1);
+}
+
+// --- CONCURRENCY ---
+
+TEST(AtomicSharedPtrTest, ReadersToppingUpPastStalledReader) {
+    {
+        AtomicSharedPtr<Tracked> a(make_shared<Tracked>(1));
+
+        //Parks in the first top-up, holding everything it loaded so far
+        std::vector<SharedPtr<Tracked>> stalled_held;
+        std::thread staller([&] {
+            t_stall_here = true;
+            while (t_stall_here) {
+                stalled_held.push_back(a.load());
+            }
+        });
+        while (!g_stalled.load()) {
+            std::this_thread::yield();
+        }
+
+        //Far more loads than the 16-bit local count while it is parked
+        constexpr int kReaders = 4;
+        std::vector<std::vector<SharedPtr<Tracked>>> held(kReaders);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < kReaders; ++t) {
+            readers.emplace_back([&, t] {
+                for (int i = 0; i < 40'000; ++i) {
+                    held[t].push_back(a.load());
+                }
+            });
+        }
+        for (auto& th : readers) {
+            th.join();
+        }
+        a.store(make_shared<Tracked>(2));
+        g_resume.store(true);
+        staller.join();
+        EXPECT_EQ(g_live, 2);
+
+        //Every load was counted: the first object lives until the last one goes
+        held.clear();
+        EXPECT_EQ(g_live, 2);
+        stalled_held.resize(1);
+        EXPECT_EQ(stalled_held[0]->value, 1);
+        stalled_held.clear();
+        EXPECT_EQ(g_live, 1);
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST(AtomicSharedPtrTest, ReadersWithWriter) {
+    {
+        AtomicSharedPtr<Tracked> a(make_shared<Tracked>(0));
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&] {
+                int last = 0;
+                while (!done.load(std::memory_order_acquire)) {
+                    SharedPtr<Tracked> p = a.load();
+                    EXPECT_GE(p->value, last); // Versions only go up
+                    last = p->value;
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (int v = 1; v <= 2000; ++v) {
+            if (v % 2 == 0) {
+                a.store(make_shared<Tracked>(v));
+            }
+            else {
+                SharedPtr<Tracked> expected = a.load();
+                EXPECT_TRUE(a.compare_exchange_strong(expected, make_shared<Tracked>(v)));
+            }
+            if (v % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& th : readers) {
+            th.join();
+        }
+        EXPECT_EQ(a.load()->value, 2000);
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST(AtomicSharedPtrTest, ConcurrentCompareExchangeCounts) {
+    struct Counter {
+        int n;
+    };
+    AtomicSharedPtr<Counter> a(make_shared<Counter>(Counter{0}));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 500; ++i) {
+                SharedPtr<Counter> expected = a.load();
+                while (!a.compare_exchange_weak(expected, make_shared<Counter>(Counter{expected->n + 1}))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(a.load()->n, 2000); // No lost update
+}
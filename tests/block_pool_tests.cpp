@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "memory/BlockPool.h"
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace My;
+
+// --- BASICS ---
+
+TEST(BlockPoolTest, FreedBlockIsReused) {
+    auto& pool = FixedBlockPool<48>::instance();
+    void* a = pool.allocate();
+    pool.deallocate(a);
+    void* b = pool.allocate();
+    EXPECT_EQ(a, b); // LIFO thread cache
+    pool.deallocate(b);
+}
+
+TEST(BlockPoolTest, BlocksAreDistinctAndAligned) {
+    using Pool = FixedBlockPool<40, 64>;
+    static_assert(Pool::kBlockSize == 64);
+
+    std::vector<void*> blocks;
+    std::set<void*> unique;
+    for (int i = 0; i < 1000; ++i) { // Several slabs
+        void* p = Pool::instance().allocate();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+        std::memset(p, 0xab, 40);  // Whole block is usable
+        blocks.push_back(p);
+        unique.insert(p);
+    }
+    EXPECT_EQ(unique.size(), blocks.size());
+    for (void* p : blocks) {
+        Pool::instance().deallocate(p);
+    }
+}
+
+// --- THREAD CACHE ---
+
+TEST(BlockPoolTest, CacheIsBoundedAndRefills) {
+    using Pool = FixedBlockPool<24>;
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 3 * Pool::kCacheLimit; ++i) {
+        blocks.push_back(Pool::instance().allocate());
+    }
+    for (void* p : blocks) {
+        Pool::instance().deallocate(p);
+        EXPECT_LE(Pool::instance().cached(), Pool::kCacheLimit);
+    }
+    EXPECT_GT(Pool::instance().cached(), 0u);
+}
+
+TEST(BlockPoolTest, FreeOnAnotherThread) {
+    using Pool = FixedBlockPool<32>;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 500; ++i) {
+        blocks.push_back(Pool::instance().allocate());
+    }
+    //Freed into the other thread's cache, handed back to the shared list on exit
+    std::thread other([&] {
+        for (void* p : blocks) {
+            Pool::instance().deallocate(p);
+        }
+        EXPECT_GT(Pool::instance().cached(), 0u);
+    });
+    other.join();
+
+    //This thread can get them again
+    std::set<void*> freed(blocks.begin(), blocks.end());
+    size_t reused = 0;
+    std::vector<void*> again;
+    for (int i = 0; i < 2000; ++i) {
+        void* p = Pool::instance().allocate();
+        reused += freed.count(p);
+        again.push_back(p);
+    }
+    EXPECT_EQ(reused, freed.size());
+    for (void* p : again) {
+        Pool::instance().deallocate(p);
+    }
+}
+
+TEST(BlockPoolTest, FreeAfterThreadCacheDestroyed) {
+    using Pool = FixedBlockPool<56>;
+    struct LateFree {
+        void* block = nullptr;
+        ~LateFree() {
+            Pool::instance().deallocate(block);
+        }
+    };
+
+    void* late_block = nullptr;
+    std::thread other([&] {
+        //Constructed before the cache, so destroyed after it
+        thread_local LateFree late;
+        late.block = Pool::instance().allocate();
+        late_block = late.block;
+    });
+    other.join();
+
+    //Went to the shared list instead of the dead cache
+    size_t found = 0;
+    std::vector<void*> again;
+    for (int i = 0; i < 2000; ++i) {
+        void* p = Pool::instance().allocate();
+        found += (p == late_block);
+        again.push_back(p);
+    }
+    EXPECT_EQ(found, 1u);
+    for (void* p : again) {
+        Pool::instance().deallocate(p);
+    }
+}
+
+TEST(BlockPoolTest, ConcurrentChurn) {
+    using Pool = FixedBlockPool<64>;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            std::vector<uint64_t*> live;
+            for (int i = 0; i < 5000; ++i) {
+                auto* p = static_cast<uint64_t*>(Pool::instance().allocate());
+                *p = uint64_t(t) << 32 | uint64_t(i);
+                live.push_back(p);
+                if (live.size() > 300) {
+                    for (size_t k = 0; k < 200; ++k) {
+                        EXPECT_EQ(*live.back() >> 32, uint64_t(t)); // Nobody else got it
+                        Pool::instance().deallocate(live.back());
+                        live.pop_back();
+                    }
+                }
+            }
+            for (auto* p : live) {
+                Pool::instance().deallocate(p);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+}
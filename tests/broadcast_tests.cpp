@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include "queues/BroadcastRing.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class BroadcastRingTest : public ::testing::Test {};
+
+// 1. Basic Single-Threaded Logic
+TEST_F(BroadcastRingTest, EveryReaderSeesEveryMessage) {
+    My::BroadcastRing<int> ring(4, 2);
+    auto a = ring.reader(0);
+    auto b = ring.reader(1);
+    int val;
+
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+
+    EXPECT_TRUE(a.read(val)); EXPECT_EQ(val, 1);
+    EXPECT_TRUE(a.read(val)); EXPECT_EQ(val, 2);
+    EXPECT_FALSE(a.read(val));
+
+    EXPECT_EQ(b.available(), 2u);
+    EXPECT_TRUE(b.read(val)); EXPECT_EQ(val, 1);
+    EXPECT_TRUE(b.read(val)); EXPECT_EQ(val, 2);
+}
+
+TEST_F(BroadcastRingTest, ProducerGatesOnSlowestReader) {
+    My::BroadcastRing<int> ring(4, 2);
+    auto fast = ring.reader(0);
+    auto slow = ring.reader(1);
+    int val;
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.push(i));
+    }
+    while (fast.read(val)) {}
+    EXPECT_FALSE(ring.push(4)); // Slow reader still holds the whole ring
+
+    EXPECT_TRUE(slow.read(val)); EXPECT_EQ(val, 0);
+    EXPECT_TRUE(ring.push(4));  // One slot freed by the slowest reader
+    EXPECT_FALSE(ring.push(5));
+}
+
+TEST_F(BroadcastRingTest, PeekIsZeroCopy) {
+    My::BroadcastRing<std::string> ring(2, 2);
+    auto a = ring.reader(0);
+    auto b = ring.reader(1);
+
+    EXPECT_EQ(a.peek(), nullptr);
+    EXPECT_TRUE(ring.push(std::string(64, 'x')));
+
+    const std::string* pa = a.peek();
+    const std::string* pb = b.peek();
+    ASSERT_NE(pa, nullptr);
+    EXPECT_EQ(pa, pb); // Both readers look at the same object
+    EXPECT_EQ(pa->size(), 64u);
+    a.advance();
+    b.advance();
+    EXPECT_EQ(a.peek(), nullptr);
+}
+
+namespace {
+    int g_live = 0;
+    bool g_throw = false;
+
+    // Throws from its constructor on demand; counts live objects
+    struct Fragile {
+        explicit Fragile(int v): value(v) {
+            if (g_throw) throw std::runtime_error("Fragile");
+            g_live++;
+        }
+        Fragile(const Fragile& other): value(other.value) { g_live++; }
+        Fragile& operator=(const Fragile&) = default;
+        ~Fragile() { g_live--; }
+        int value;
+    };
+}
+
+TEST_F(BroadcastRingTest, ThrowingConstructorKeepsOldMessage) {
+    {
+        My::BroadcastRing<Fragile> ring(2, 1);
+        auto r = ring.reader(0);
+        EXPECT_TRUE(ring.emplace(1));
+        EXPECT_TRUE(ring.emplace(2));
+        EXPECT_EQ(r.peek()->value, 1);
+        r.advance();
+
+        //Second lap: the slot holds message 1
+        g_throw = true;
+        EXPECT_THROW(ring.emplace(3), std::runtime_error);
+        g_throw = false;
+        EXPECT_EQ(ring.published(), 2u);
+        EXPECT_EQ(g_live, 2);
+
+        EXPECT_TRUE(ring.emplace(4));
+        EXPECT_EQ(r.peek()->value, 2);
+        r.advance();
+        EXPECT_EQ(r.peek()->value, 4);
+    }
+    EXPECT_EQ(g_live, 0); // Each slot destroyed exactly once
+}
+
+// 2. Lossy mode
+TEST_F(BroadcastRingTest, LossyReaderDetectsGap) {
+    My::BroadcastRing<int, My::BroadcastMode::Lossy> ring(4, 1);
+    auto reader = ring.reader(0);
+    int val;
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring.push(i)); // Never blocks
+    }
+    // Ring holds 4; one slot is treated as possibly in flight
+    EXPECT_TRUE(reader.read(val));
+    EXPECT_EQ(val, 7);
+    EXPECT_EQ(reader.missed(), 7u);
+    EXPECT_TRUE(reader.read(val)); EXPECT_EQ(val, 8);
+    EXPECT_TRUE(reader.read(val)); EXPECT_EQ(val, 9);
+    EXPECT_FALSE(reader.read(val));
+}
+
+// 3. Concurrency Stress
+TEST_F(BroadcastRingTest, BlockingReadersSeeAllInOrder) {
+    const int num_readers = 3;
+    const int num_messages = 300'000;
+    My::BroadcastRing<int> ring(256, num_readers);
+    std::vector<long long> sums(num_readers, 0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < num_readers; ++r) {
+        readers.emplace_back([&, r]() {
+            auto reader = ring.reader(r);
+            int expected = 0;
+            while (expected < num_messages) {
+                const int* item = reader.peek();
+                if (item == nullptr) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ASSERT_EQ(*item, expected);
+                sums[r] += *item;
+                reader.advance();
+                expected++;
+            }
+        });
+    }
+    for (int i = 0; i < num_messages; ++i) {
+        while (!ring.push(i)) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    const long long expected_sum = static_cast<long long>(num_messages) * (num_messages - 1) / 2;
+    for (int r = 0; r < num_readers; ++r) {
+        EXPECT_EQ(sums[r], expected_sum);
+    }
+}
+
+struct Tick {
+    int64_t seq;
+    int64_t check;
+};
+
+TEST_F(BroadcastRingTest, LossyReadersAccountForEveryMessage) {
+    const int num_readers = 2;
+    const int64_t num_messages = 300'000;
+    My::BroadcastRing<Tick, My::BroadcastMode::Lossy> ring(64, num_readers);
+    std::atomic<bool> done = false;
+    std::vector<int64_t> received(num_readers, 0);
+    std::vector<uint64_t> missed(num_readers, 0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < num_readers; ++r) {
+        readers.emplace_back([&, r]() {
+            auto reader = ring.reader(r);
+            int64_t last = -1;
+            Tick tick;
+            while (true) {
+                const bool finished = done.load(std::memory_order_acquire);
+                if (reader.read(tick)) {
+                    ASSERT_EQ(tick.check, -tick.seq); // Never torn
+                    ASSERT_GT(tick.seq, last);        // Never repeated or reordered
+                    last = tick.seq;
+                    received[r]++;
+                } else if (finished) {
+                    break;
+                }
+            }
+            missed[r] = reader.missed();
+        });
+    }
+    for (int64_t i = 0; i < num_messages; ++i) {
+        ring.push(Tick{i, -i});
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    for (int r = 0; r < num_readers; ++r) {
+        EXPECT_EQ(received[r] + static_cast<int64_t>(missed[r]), num_messages);
+    }
+}
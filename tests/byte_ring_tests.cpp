@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "queues/ByteRing.h"
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ByteRingTest : public ::testing::Test {
+protected:
+    static std::span<const std::byte> bytes(const std::string& s) {
+        return std::as_bytes(std::span<const char>(s.data(), s.size()));
+    }
+    static std::string text(std::span<const std::byte> b) {
+        return std::string(reinterpret_cast<const char*>(b.data()), b.size());
+    }
+};
+
+// 1. Basic Single-Threaded Logic
+TEST_F(ByteRingTest, VariableLengthMessagesKeepTheirSize) {
+    My::ByteRing ring(256);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_TRUE(ring.push(bytes("hi")));
+    EXPECT_TRUE(ring.push(bytes("a much longer message")));
+
+    EXPECT_EQ(text(ring.peek()), "hi");
+    ring.release();
+    EXPECT_EQ(ring.next_size(), 21u);
+    EXPECT_EQ(text(ring.peek()), "a much longer message");
+    ring.release();
+    EXPECT_TRUE(ring.peek().empty());
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(ByteRingTest, ReserveAndCommitInPlace) {
+    My::ByteRing ring(128);
+    std::span<std::byte> slot = ring.reserve(32);
+    ASSERT_EQ(slot.size(), 32u);
+    std::memcpy(slot.data(), "abc", 3);
+    ring.commit(3); // Trim to what was actually written
+
+    EXPECT_EQ(text(ring.peek()), "abc");
+    ring.release();
+
+    // commit(0) abandons the reservation
+    ring.reserve(16);
+    ring.commit(0);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(ByteRingTest, RejectsWhenFullOrTooLarge) {
+    My::ByteRing ring(64); // max_message = 24
+    EXPECT_EQ(ring.max_message(), 24u);
+    EXPECT_TRUE(ring.reserve(25).empty());
+
+    std::string msg(24, 'x'); // 32-byte record
+    EXPECT_TRUE(ring.push(bytes(msg)));
+    EXPECT_TRUE(ring.push(bytes(msg)));
+    EXPECT_FALSE(ring.push(bytes("y"))); // Full
+
+    std::vector<std::byte> small(4);
+    EXPECT_EQ(ring.pop(small), 0u); // Too small to take the message
+    std::vector<std::byte> big(64);
+    EXPECT_EQ(ring.pop(big), 24u);
+    EXPECT_TRUE(ring.push(bytes("y")));
+}
+
+// 2. Wrap-Around Padding
+TEST_F(ByteRingTest, RecordThatDoesNotFitBeforeTheEndWraps) {
+    My::ByteRing ring(64);
+    std::vector<std::byte> out(64);
+
+    EXPECT_TRUE(ring.push(bytes(std::string(20, 'a')))); // [0, 32)
+    EXPECT_TRUE(ring.push(bytes(std::string(8, 'b'))));  // [32, 48)
+    EXPECT_EQ(ring.pop(out), 20u);
+
+    // 24 bytes need a 32-byte record: only 16 left before the end, so it is
+    // padded and placed at offset 0
+    EXPECT_TRUE(ring.push(bytes(std::string(24, 'c'))));
+    EXPECT_EQ(ring.size(), 16u + 16u + 32u);
+
+    EXPECT_EQ(text(ring.peek()), std::string(8, 'b'));
+    ring.release();
+    EXPECT_EQ(text(ring.peek()), std::string(24, 'c'));
+    EXPECT_EQ(text(ring.peek()), std::string(24, 'c')); // Peek twice, release once
+    ring.release();
+    EXPECT_TRUE(ring.empty());
+}
+
+// 3. Concurrency Stress Test
+TEST_F(ByteRingTest, ProducerConsumerVariableSizes) {
+    My::ByteRing ring(1024);
+    const uint32_t N = 20000;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < N; ++i) {
+            const size_t len = 4 + (i * 37) % 300;
+            std::span<std::byte> slot;
+            while ((slot = ring.reserve(len)).empty()) { std::this_thread::yield(); }
+            std::memcpy(slot.data(), &i, 4);
+            std::memset(slot.data() + 4, static_cast<int>(i & 0xff), len - 4);
+            ring.commit(len);
+        }
+    });
+
+    bool ok = true;
+    for (uint32_t i = 0; i < N; ++i) {
+        std::span<const std::byte> msg;
+        while ((msg = ring.peek()).empty()) { std::this_thread::yield(); }
+        uint32_t seq;
+        std::memcpy(&seq, msg.data(), 4);
+        ok &= (seq == i && msg.size() == 4 + (i * 37) % 300);
+        for (size_t j = 4; j < msg.size(); ++j) {
+            ok &= (msg[j] == static_cast<std::byte>(i & 0xff));
+        }
+        ring.release();
+    }
+    producer.join();
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(ring.empty());
+}
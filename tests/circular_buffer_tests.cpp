@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include "queues/CircularBuffer.h"
+#include "queues/StaticCircularBuffer.h"
+#include <memory>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 class CircularBufferTest : public ::testing::Test {};
 
@@ -82,3 +88,204 @@ TEST_F(CircularBufferTest, MoveOnlySemantics) {
     ASSERT_NE(out, nullptr);
     EXPECT_EQ(*out, 10);
 }
+
+TEST_F(CircularBufferTest, OverwriteEvictsOldest) {
+    My::CircularBuffer<int> cb(3, My::OverflowPolicy::Overwrite);
+    int val;
+
+    for (int i = 1; i <= 5; ++i) {
+        EXPECT_TRUE(cb.push(i)); // Never fails
+    }
+    EXPECT_TRUE(cb.full());
+    EXPECT_EQ(cb.front(), 3);
+    EXPECT_EQ(cb.back(), 5);
+
+    EXPECT_TRUE(cb.pop(val)); EXPECT_EQ(val, 3);
+    EXPECT_TRUE(cb.push(6));
+    EXPECT_TRUE(cb.push(7)); // Evicts 4
+    EXPECT_TRUE(cb.pop(val)); EXPECT_EQ(val, 5);
+    EXPECT_TRUE(cb.pop(val)); EXPECT_EQ(val, 6);
+    EXPECT_TRUE(cb.pop(val)); EXPECT_EQ(val, 7);
+    EXPECT_FALSE(cb.pop(val));
+}
+
+TEST_F(CircularBufferTest, RandomAccessIsRelativeToHead) {
+    My::CircularBuffer<int> cb(4, My::OverflowPolicy::Overwrite);
+    for (int i = 0; i < 6; ++i) {
+        cb.push(i); // Window is 2, 3, 4, 5 and wraps in storage
+    }
+    for (size_t i = 0; i < cb.size(); ++i) {
+        EXPECT_EQ(cb[i], static_cast<int>(i) + 2);
+    }
+    cb[0] = 42;
+    EXPECT_EQ(cb.front(), 42);
+}
+
+TEST_F(CircularBufferTest, SpansCoverTheWindowInOrder) {
+    My::CircularBuffer<int> cb(5, My::OverflowPolicy::Overwrite);
+
+    auto [a, b] = cb.as_spans();
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(b.empty());
+
+    cb.push(1); cb.push(2); cb.push(3);
+    auto [c, d] = cb.as_spans(); // Not wrapped: one run
+    EXPECT_EQ(c.size(), 3u);
+    EXPECT_TRUE(d.empty());
+
+    for (int i = 4; i <= 8; ++i) {
+        cb.push(i); // Window 4..8, head at slot 3
+    }
+    const auto& ccb = cb;
+    auto [first, second] = ccb.as_spans();
+    EXPECT_EQ(first.size() + second.size(), 5u);
+    std::vector<int> joined(first.begin(), first.end());
+    joined.insert(joined.end(), second.begin(), second.end());
+    EXPECT_EQ(joined, (std::vector<int>{4, 5, 6, 7, 8}));
+}
+
+TEST_F(CircularBufferTest, IteratorsWalkOldestToNewest) {
+    static_assert(std::random_access_iterator<My::CircularBuffer<int>::iterator>);
+    static_assert(std::random_access_iterator<My::CircularBuffer<int>::const_iterator>);
+
+    My::CircularBuffer<int> cb(4, My::OverflowPolicy::Overwrite);
+    for (int i = 0; i < 7; ++i) {
+        cb.push(i);
+    }
+    std::vector<int> seen(cb.begin(), cb.end());
+    EXPECT_EQ(seen, (std::vector<int>{3, 4, 5, 6}));
+    EXPECT_EQ(std::accumulate(cb.cbegin(), cb.cend(), 0), 18);
+    EXPECT_EQ(cb.end() - cb.begin(), 4);
+    EXPECT_EQ(*(cb.begin() + 2), 5);
+
+    for (int& x : cb) {
+        x *= 10;
+    }
+    EXPECT_EQ(cb.back(), 60);
+}
+
+// --- StaticCircularBuffer<T, N> ---
+
+namespace {
+    struct NoDefault {
+        explicit NoDefault(int v): value(v) {}
+        int value;
+    };
+
+    // Pushes 1..6 through a 4-slot ring (so it wraps) and sums what comes out
+    constexpr int static_ring_sum() {
+        My::StaticCircularBuffer<int, 4> ring;
+        int sum = 0;
+        int val = 0;
+        for (int i = 1; i <= 6; ++i) {
+            if (ring.full()) {
+                ring.pop(val);
+                sum += val;
+            }
+            ring.push(i);
+        }
+        while (ring.pop(val)) {
+            sum += val;
+        }
+        return sum;
+    }
+}
+
+TEST_F(CircularBufferTest, StaticBufferIsConstexpr) {
+    static_assert(static_ring_sum() == 21);
+    static_assert(My::StaticCircularBuffer<int, 8>::capacity() == 8);
+    // Inline storage: N slots plus two indices, nothing else
+    static_assert(sizeof(My::StaticCircularBuffer<int, 8>) == 8 * sizeof(int) + 2 * sizeof(size_t));
+}
+
+TEST_F(CircularBufferTest, StaticBufferWrapsWithFreeRunningIndices) {
+    My::StaticCircularBuffer<int, 4> ring;
+    int val;
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(ring.push(round * 4 + i));
+        }
+        EXPECT_TRUE(ring.full());
+        EXPECT_FALSE(ring.push(-1));
+        EXPECT_EQ(ring.front(), round * 4);
+        EXPECT_EQ(ring.back(), round * 4 + 3);
+        EXPECT_EQ(ring[2], round * 4 + 2);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(ring.pop(val));
+            EXPECT_EQ(val, round * 4 + i);
+        }
+        EXPECT_TRUE(ring.pop(val));
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+TEST_F(CircularBufferTest, StaticBufferNeedsNoDefaultConstructor) {
+    My::StaticCircularBuffer<NoDefault, 2> ring;
+    EXPECT_TRUE(ring.emplace(7));
+    EXPECT_TRUE(ring.push(NoDefault(8)));
+    EXPECT_EQ(ring.front().value, 7);
+    EXPECT_EQ(ring.back().value, 8);
+}
+
+TEST_F(CircularBufferTest, StaticBufferOwnsItsElements) {
+    auto counter = std::make_shared<int>(0);
+    {
+        My::StaticCircularBuffer<std::shared_ptr<int>, 4> ring;
+        ring.push(counter);
+        ring.push(counter);
+        EXPECT_EQ(counter.use_count(), 3);
+
+        auto copy = ring;
+        EXPECT_EQ(counter.use_count(), 5);
+        auto moved = std::move(copy);
+        EXPECT_EQ(counter.use_count(), 5); // Moved-from copy's pointers are null but still live
+        copy.clear();
+        EXPECT_EQ(counter.use_count(), 5);
+
+        std::shared_ptr<int> out;
+        EXPECT_TRUE(moved.pop(out));
+        out.reset();
+        EXPECT_EQ(counter.use_count(), 4);
+    }
+    EXPECT_EQ(counter.use_count(), 1); // Destructor released the rest
+}
+
+namespace {
+    int g_live = 0;
+
+    // Copy throws when the source asks it to; counts live objects
+    struct FragileCopy {
+        int value;
+        bool throw_on_copy;
+
+        explicit FragileCopy(int v, bool t = false): value(v), throw_on_copy(t) { g_live++; }
+        FragileCopy(const FragileCopy& other): value(other.value), throw_on_copy(false) {
+            if (other.throw_on_copy) throw std::runtime_error("FragileCopy");
+            g_live++;
+        }
+        ~FragileCopy() { g_live--; }
+    };
+}
+
+TEST_F(CircularBufferTest, StaticBufferCopyThrowDestroysPartialCopy) {
+    {
+        My::StaticCircularBuffer<FragileCopy, 4> ring;
+        ring.emplace(1);
+        ring.emplace(2);
+        ring.emplace(3, true);
+        using Ring = My::StaticCircularBuffer<FragileCopy, 4>;
+        EXPECT_THROW(Ring copy(ring), std::runtime_error);
+        EXPECT_EQ(g_live, 3); // The two copies made before the throw are gone
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST_F(CircularBufferTest, StaticBufferMoveOnly) {
+    My::StaticCircularBuffer<std::unique_ptr<int>, 2> ring;
+    EXPECT_TRUE(ring.push(std::make_unique<int>(10)));
+    std::unique_ptr<int> out;
+    EXPECT_TRUE(ring.pop(out));
+    ASSERT_NE(out, nullptr);
+    EXPECT_EQ(*out, 10);
+}
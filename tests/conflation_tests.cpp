@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "queues/ConflationQueue.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Quote {
+    double bid;
+    double ask;
+    int64_t seq;
+};
+
+class ConflationQueueTest : public ::testing::Test {};
+
+// 1. Basic Single-Threaded Logic
+TEST_F(ConflationQueueTest, DeliversInFirstPendingOrder) {
+    My::ConflationQueue<int, Quote> queue(8);
+    int key;
+    Quote quote;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.push(1, {10.0, 10.5, 1}));
+    EXPECT_TRUE(queue.push(2, {20.0, 20.5, 2}));
+    EXPECT_EQ(queue.size(), 2u);
+
+    EXPECT_TRUE(queue.pop(key, quote));
+    EXPECT_EQ(key, 1);
+    EXPECT_EQ(quote.seq, 1);
+    EXPECT_TRUE(queue.pop(key, quote));
+    EXPECT_EQ(key, 2);
+    EXPECT_FALSE(queue.pop(key, quote));
+}
+
+TEST_F(ConflationQueueTest, OverwritesPendingValue) {
+    My::ConflationQueue<std::string, Quote> queue(4);
+    std::string key;
+    Quote quote;
+
+    EXPECT_TRUE(queue.push("AAPL", {1.0, 1.1, 1}));
+    EXPECT_TRUE(queue.push("MSFT", {2.0, 2.1, 2}));
+    EXPECT_TRUE(queue.push("AAPL", {1.5, 1.6, 3})); // Conflated, keeps its place
+    EXPECT_TRUE(queue.push("AAPL", {1.7, 1.8, 4})); // Conflated again
+
+    EXPECT_EQ(queue.size(), 2u); // Memory is bounded by keys, not updates
+    EXPECT_EQ(queue.pushed(), 4u);
+    EXPECT_EQ(queue.conflated(), 2u);
+
+    EXPECT_TRUE(queue.pop(key, quote));
+    EXPECT_EQ(key, "AAPL");
+    EXPECT_EQ(quote.seq, 4); // Latest value only
+    EXPECT_TRUE(queue.pop(key, quote));
+    EXPECT_EQ(key, "MSFT");
+    EXPECT_EQ(queue.delivered(), 2u);
+
+    // Once read, the next update queues again
+    EXPECT_TRUE(queue.push("AAPL", {1.9, 2.0, 5}));
+    EXPECT_TRUE(queue.pop(key, quote));
+    EXPECT_EQ(quote.seq, 5);
+}
+
+TEST_F(ConflationQueueTest, RejectsNewKeysWhenFull) {
+    My::ConflationQueue<int, int> queue(2);
+    EXPECT_TRUE(queue.push(1, 1));
+    EXPECT_TRUE(queue.push(2, 2));
+    EXPECT_FALSE(queue.push(3, 3)); // Out of keys
+    EXPECT_TRUE(queue.push(1, 4));  // Known keys still conflate
+    EXPECT_EQ(queue.conflated(), 1u);
+}
+
+// 2. Concurrency Stress
+TEST_F(ConflationQueueTest, ConsumerSeesMonotonicLatestValues) {
+    const int num_keys = 64;
+    const int64_t updates = 500'000;
+    My::ConflationQueue<int, Quote> queue(num_keys);
+    std::atomic<bool> done = false;
+    std::vector<int64_t> last_seen(num_keys, -1);
+
+    std::thread consumer([&]() {
+        int key;
+        Quote quote;
+        while (true) {
+            const bool finished = done.load(std::memory_order_acquire);
+            bool got_any = false;
+            while (queue.pop(key, quote)) {
+                got_any = true;
+                // Torn reads would break the bid/ask/seq relationship
+                ASSERT_EQ(quote.bid, static_cast<double>(quote.seq));
+                ASSERT_EQ(quote.ask, static_cast<double>(quote.seq) + 0.5);
+                // Per key, values only move forward and are never repeated
+                ASSERT_GT(quote.seq, last_seen[key]);
+                last_seen[key] = quote.seq;
+            }
+            if (finished && !got_any) {
+                break;
+            }
+        }
+    });
+
+    for (int64_t i = 0; i < updates; ++i) {
+        const double v = static_cast<double>(i);
+        ASSERT_TRUE(queue.push(static_cast<int>(i % num_keys), {v, v + 0.5, i}));
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    // Every key ends on its final update
+    for (int k = 0; k < num_keys; ++k) {
+        EXPECT_EQ(last_seen[k], (updates - 1 - k) / num_keys * num_keys + k);
+    }
+    EXPECT_EQ(queue.pushed(), static_cast<uint64_t>(updates));
+    EXPECT_LE(queue.delivered() + queue.conflated(), static_cast<uint64_t>(updates));
+}
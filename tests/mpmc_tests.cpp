@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "queues/MpmcQueue.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MpmcQueueTest : public ::testing::Test {};
+
+// 1. Basic Single-Threaded Logic
+TEST_F(MpmcQueueTest, BasicPushPop) {
+    My::MpmcQueue<int> queue(4);
+    int val;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_EQ(queue.size(), 2u);
+
+    EXPECT_TRUE(queue.pop(val)); EXPECT_EQ(val, 1);
+    EXPECT_TRUE(queue.pop(val)); EXPECT_EQ(val, 2);
+    EXPECT_FALSE(queue.pop(val));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(MpmcQueueTest, FullBehaviorAndRounding) {
+    My::MpmcQueue<int> queue(3); // Rounded up to 4
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.push(99));
+
+    // Wrap a few laps
+    int val;
+    for (int i = 4; i < 40; ++i) {
+        EXPECT_TRUE(queue.pop(val)); EXPECT_EQ(val, i - 4);
+        EXPECT_TRUE(queue.push(i));
+    }
+}
+
+TEST_F(MpmcQueueTest, MoveSemanticsAndCleanup) {
+    auto shared = std::make_shared<int>(7);
+    {
+        My::MpmcQueue<std::shared_ptr<int>> queue(4);
+        EXPECT_TRUE(queue.push(shared));
+        EXPECT_TRUE(queue.push(shared));
+        EXPECT_EQ(shared.use_count(), 3);
+
+        std::shared_ptr<int> out;
+        EXPECT_TRUE(queue.pop(out));
+        EXPECT_EQ(*out, 7);
+    }
+    // One popped into `out` (gone), one destroyed with the queue
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+// 2. Batch Operations
+TEST_F(MpmcQueueTest, BulkPushPop) {
+    My::MpmcQueue<std::string> queue(8);
+    const std::string batch[10] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+    std::string out[10];
+
+    EXPECT_EQ(queue.push_bulk(batch, 10), 8u); // Partial: only 8 slots
+    EXPECT_EQ(queue.push_bulk(batch, 1), 0u);
+
+    EXPECT_EQ(queue.pop_bulk(out, 3), 3u);
+    EXPECT_EQ(out[2], "2");
+    EXPECT_EQ(queue.push_bulk(batch + 8, 2), 2u); // Wraps
+
+    EXPECT_EQ(queue.pop_bulk(out, 10), 7u);
+    EXPECT_EQ(out[0], "3");
+    EXPECT_EQ(out[6], "9");
+    EXPECT_EQ(queue.pop_bulk(out, 10), 0u);
+}
+
+namespace {
+    // Copy throws when asked to; moves are noexcept
+    struct CopyThrows {
+        int value = 0;
+        bool throw_on_copy = false;
+
+        CopyThrows() = default;
+        explicit CopyThrows(int v, bool t = false): value(v), throw_on_copy(t) {}
+        CopyThrows(const CopyThrows& other): value(other.value) {
+            if (other.throw_on_copy) throw std::runtime_error("CopyThrows");
+        }
+        CopyThrows(CopyThrows&&) noexcept = default;
+        CopyThrows& operator=(CopyThrows&&) noexcept = default;
+    };
+}
+
+TEST_F(MpmcQueueTest, ThrowingCopyLeavesQueueUsable) {
+    My::MpmcQueue<CopyThrows> queue(4);
+    const CopyThrows bad(1, true);
+    EXPECT_THROW(queue.push(bad), std::runtime_error);
+    EXPECT_TRUE(queue.empty()); // No cell claimed
+
+    const CopyThrows batch[3] = {CopyThrows(2), CopyThrows(3, true), CopyThrows(4)};
+    EXPECT_THROW(queue.push_bulk(batch, 3), std::runtime_error);
+    EXPECT_TRUE(queue.push(CopyThrows(5)));
+
+    //The item before the throw went in; nothing is wedged
+    CopyThrows out;
+    EXPECT_TRUE(queue.pop(out)); EXPECT_EQ(out.value, 2);
+    EXPECT_TRUE(queue.pop(out)); EXPECT_EQ(out.value, 5);
+    EXPECT_FALSE(queue.pop(out));
+}
+
+// 3. Concurrency Stress: every item delivered exactly once, per-producer FIFO
+TEST_F(MpmcQueueTest, ManyProducersManyConsumers) {
+    const int num_producers = 4;
+    const int num_consumers = 4;
+    const int per_producer = 200'000;
+
+    My::MpmcQueue<uint64_t> queue(256);
+    std::atomic<int> consumed = 0;
+    std::vector<std::vector<int>> seen(num_consumers, std::vector<int>(num_producers, -1));
+    std::vector<std::vector<int>> counts(num_consumers, std::vector<int>(num_producers, 0));
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            uint64_t batch[16];
+            while (consumed.load(std::memory_order_relaxed) < num_producers * per_producer) {
+                // Alternate single and bulk pops
+                size_t n = (c % 2 == 0) ? queue.pop_bulk(batch, 16) : (queue.pop(batch[0]) ? 1 : 0);
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    const int producer = static_cast<int>(batch[i] >> 32);
+                    const int value = static_cast<int>(batch[i] & 0xffffffff);
+                    // A producer's items reach any one consumer in order
+                    ASSERT_GT(value, seen[c][producer]);
+                    seen[c][producer] = value;
+                    counts[c][producer]++;
+                }
+                consumed.fetch_add(static_cast<int>(n), std::memory_order_relaxed);
+            }
+        });
+    }
+    for (int p = 0; p < num_producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                const uint64_t item = (static_cast<uint64_t>(p) << 32) | static_cast<uint64_t>(i);
+                if (p % 2 == 0) {
+                    while (!queue.push(item)) { std::this_thread::yield(); }
+                } else {
+                    while (queue.push_bulk(&item, 1) == 0) { std::this_thread::yield(); }
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (int p = 0; p < num_producers; ++p) {
+        int total = 0;
+        for (int c = 0; c < num_consumers; ++c) {
+            total += counts[c][p];
+        }
+        EXPECT_EQ(total, per_producer) << "Producer " << p;
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "analytics/RollingWindow.h"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+
+class RollingWindowTest : public ::testing::Test {
+protected:
+    // Full recompute over the same window, the reference answer
+    struct Naive {
+        std::deque<double> values;
+        size_t window;
+
+        void push(double x) {
+            values.push_back(x);
+            if (values.size() > window) {
+                values.pop_front();
+            }
+        }
+        double sum() const { return std::accumulate(values.begin(), values.end(), 0.0); }
+        double mean() const { return sum() / values.size(); }
+        double variance() const {
+            const double m = mean();
+            double acc = 0;
+            for (double v : values) {
+                acc += (v - m) * (v - m);
+            }
+            return values.size() < 2 ? 0.0 : acc / (values.size() - 1);
+        }
+        double min() const { return *std::min_element(values.begin(), values.end()); }
+        double max() const { return *std::max_element(values.begin(), values.end()); }
+    };
+};
+
+// 1. Basic Logic
+TEST_F(RollingWindowTest, SmallWindowByHand) {
+    My::RollingWindow<double, My::RollingSum, My::RollingMoments, My::RollingMin, My::RollingMax> w(3);
+
+    w.push(4); w.push(1); w.push(7);
+    EXPECT_TRUE(w.full());
+    EXPECT_DOUBLE_EQ(w.get<My::RollingSum>().value(), 12);
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMoments>().mean(), 4);
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMoments>().variance(), 9);
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMin>().value(), 1);
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMax>().value(), 7);
+
+    w.push(2); // 4 leaves: 1, 7, 2
+    EXPECT_DOUBLE_EQ(w.get<My::RollingSum>().value(), 10);
+    EXPECT_EQ(w.get<My::RollingMoments>().count(), 3u);
+    w.push(3); // 1 leaves: 7, 2, 3
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMin>().value(), 2);
+    w.push(0); // 7 leaves: 2, 3, 0
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMax>().value(), 3);
+    EXPECT_DOUBLE_EQ(w.get<My::RollingMin>().value(), 0);
+}
+
+TEST_F(RollingWindowTest, UnusedAggregatesAreNotStored) {
+    using SumOnly = My::RollingWindow<double, My::RollingSum>;
+    using Everything = My::RollingWindow<double, My::RollingSum, My::RollingMoments, My::RollingMin, My::RollingMax>;
+    EXPECT_LT(sizeof(SumOnly), sizeof(Everything));
+}
+
+TEST_F(RollingWindowTest, DuplicateExtremesSurviveEviction) {
+    My::RollingWindow<int, My::RollingMax> w(3);
+    w.push(5); w.push(5); w.push(1);
+    w.push(1); // First 5 leaves, second is still in
+    EXPECT_EQ(w.get<My::RollingMax>().value(), 5);
+    w.push(1); // Second 5 leaves
+    EXPECT_EQ(w.get<My::RollingMax>().value(), 1);
+}
+
+// 2. Against a Full Recompute
+TEST_F(RollingWindowTest, MatchesRecomputeOverLongRandomRun) {
+    const size_t window = 50;
+    My::RollingWindow<double, My::RollingSum, My::RollingMoments, My::RollingMin, My::RollingMax> w(window);
+    Naive naive{{}, window};
+
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> price(100.0, 5.0);
+    for (int i = 0; i < 20000; ++i) {
+        const double x = price(rng);
+        w.push(x);
+        naive.push(x);
+        if (i % 97 == 0) {
+            ASSERT_NEAR(w.get<My::RollingSum>().value(), naive.sum(), 1e-9);
+            ASSERT_NEAR(w.get<My::RollingMoments>().mean(), naive.mean(), 1e-9);
+            ASSERT_NEAR(w.get<My::RollingMoments>().variance(), naive.variance(), 1e-6);
+            ASSERT_EQ(w.get<My::RollingMin>().value(), naive.min());
+            ASSERT_EQ(w.get<My::RollingMax>().value(), naive.max());
+        }
+    }
+}
+
+TEST_F(RollingWindowTest, CompensatedSumDoesNotDrift) {
+    // Large and tiny values: a naive add/subtract loses the tiny ones
+    My::RollingWindow<double, My::RollingSum> w(2);
+    for (int i = 0; i < 100000; ++i) {
+        w.push((i % 2) ? 1e16 : 1.0);
+    }
+    w.push(1.0);
+    w.push(1.0);
+    EXPECT_DOUBLE_EQ(w.get<My::RollingSum>().value(), 2.0);
+}
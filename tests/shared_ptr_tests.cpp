@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 #include "memory/SharedPtr.h"
+#include <atomic>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 // --- Helper for Lifecycle Tracking ---
 struct Tracker {
@@ -147,3 +153,262 @@ TEST_F(SharedPtrTest, IndependentPointers) {
     EXPECT_EQ(p1.use_count(), 1);
     EXPECT_EQ(p2.use_count(), 1);
 }
+
+// 7. WeakPtr
+TEST_F(SharedPtrTest, WeakPtrDoesNotKeepObjectAlive) {
+    My::WeakPtr<Tracker> weak;
+    EXPECT_TRUE(weak.expired());
+    {
+        My::SharedPtr<Tracker> p(new Tracker(7));
+        weak = p;
+        EXPECT_EQ(weak.use_count(), 1);
+        EXPECT_FALSE(weak.expired());
+
+        auto locked = weak.lock();
+        EXPECT_EQ(locked->value, 7);
+        EXPECT_EQ(p.use_count(), 2);
+    }
+    EXPECT_EQ(Tracker::destructed_count, 1);
+    EXPECT_TRUE(weak.expired());
+    EXPECT_FALSE(weak.lock()); // Never resurrects
+}
+
+TEST_F(SharedPtrTest, MakeSharedDestroysObjectBeforeFreeingBlock) {
+    My::WeakPtr<Tracker> weak;
+    {
+        auto p = My::make_shared<Tracker>(3);
+        weak = p;
+        My::WeakPtr<Tracker> copy = weak;
+        EXPECT_EQ(copy.lock()->value, 3);
+    }
+    // Object destroyed at refCount 0, block still held by weak
+    EXPECT_EQ(Tracker::destructed_count, 1);
+    EXPECT_EQ(weak.use_count(), 0);
+    weak.reset(); // Frees the block (ASan would flag a leak or double free)
+    EXPECT_EQ(Tracker::destructed_count, 1);
+}
+
+TEST_F(SharedPtrTest, WeakPtrCopyMoveAndReset) {
+    auto p = My::make_shared<Tracker>(1);
+    My::WeakPtr<Tracker> a(p);
+    My::WeakPtr<Tracker> b(a);
+    My::WeakPtr<Tracker> c(std::move(a));
+    EXPECT_TRUE(a.expired()); // Moved-from is empty
+    EXPECT_EQ(b.lock().get(), p.get());
+    EXPECT_EQ(c.lock().get(), p.get());
+
+    b = c;
+    c.reset();
+    EXPECT_TRUE(c.expired());
+    EXPECT_FALSE(b.expired());
+    p.reset();
+    EXPECT_TRUE(b.expired());
+}
+
+TEST_F(SharedPtrTest, LockRacesWithLastOwner) {
+    //Readers lock() while the owner drops the object: every lock either
+    //fails or gets a live object, never a destroyed one
+    for (int round = 0; round < 50; ++round) {
+        auto owner = My::make_shared<Tracker>(round);
+        My::WeakPtr<Tracker> weak(owner);
+        std::atomic<bool> go{false};
+        std::atomic<int> bad{0};
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&] {
+                while (!go.load()) std::this_thread::yield();
+                for (int i = 0; i < 200; ++i) {
+                    if (auto p = weak.lock()) {
+                        if (p->value != round) bad++;
+                    }
+                }
+            });
+        }
+        go = true;
+        owner.reset();
+        for (auto& r : readers) r.join();
+        EXPECT_EQ(bad.load(), 0);
+        EXPECT_TRUE(weak.expired());
+    }
+    EXPECT_EQ(Tracker::destructed_count, Tracker::constructed_count);
+}
+
+// 8. Concurrent copies (relaxed increment, release/acquire on the last decrement)
+TEST_F(SharedPtrTest, ConcurrentCopyAndDestroy) {
+    struct Payload {
+        int value = 0;
+    };
+    static std::atomic<int> seen_destroyed{0};
+    struct Checked {
+        Payload* payload;
+        explicit Checked(Payload* p) : payload(p) {}
+        Checked(const Checked&) = delete;
+        ~Checked() {
+            //The last owner's writes must be visible here (TSan checks it)
+            if (payload->value == 4) seen_destroyed++;
+            delete payload;
+        }
+    };
+
+    seen_destroyed = 0;
+    for (int round = 0; round < 20; ++round) {
+        auto shared = My::make_shared<Checked>(new Payload);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            My::SharedPtr<Checked> mine = shared;
+            threads.emplace_back([p = std::move(mine), t]() mutable {
+                for (int i = 0; i < 500; ++i) {
+                    My::SharedPtr<Checked> copy = p;
+                }
+                if (t == 0) p->payload->value = 4; // Written by one owner before it lets go
+                p.reset();
+            });
+        }
+        shared.reset();
+        for (auto& th : threads) th.join();
+    }
+    EXPECT_EQ(seen_destroyed.load(), 20);
+}
+
+// 9. LocalSharedPtr (non-atomic counts)
+TEST_F(SharedPtrTest, LocalSharedPtrCountsAndDestroys) {
+    {
+        auto p = My::make_local_shared<Tracker>(5);
+        My::LocalSharedPtr<Tracker> q = p;
+        EXPECT_EQ(p.use_count(), 2);
+
+        My::LocalWeakPtr<Tracker> weak(p);
+        EXPECT_EQ(weak.lock()->value, 5);
+        p.reset();
+        EXPECT_EQ(q.use_count(), 1);
+        q.reset();
+        EXPECT_TRUE(weak.expired());
+        EXPECT_FALSE(weak.lock());
+        EXPECT_EQ(Tracker::destructed_count, 1);
+    }
+    {
+        My::LocalSharedPtr<Tracker> raw(new Tracker(6));
+        raw.reset(new Tracker(7));
+        EXPECT_EQ(raw->value, 7);
+    }
+    EXPECT_EQ(Tracker::destructed_count, 3);
+}
+
+TEST_F(SharedPtrTest, LocalToSharedConversion) {
+    auto local = My::make_local_shared<Tracker>(8);
+    My::LocalSharedPtr<Tracker> local_copy = local;
+
+    My::SharedPtr<Tracker> shared(local); // Explicit; the block goes atomic
+    EXPECT_EQ(shared.use_count(), 3);
+    EXPECT_EQ(shared.get(), local.get());
+
+    //Another thread copies and drops while the local owners do the same
+    std::thread other([s = shared]() mutable {
+        for (int i = 0; i < 1000; ++i) {
+            My::SharedPtr<Tracker> copy = s;
+        }
+        s.reset();
+    });
+    for (int i = 0; i < 1000; ++i) {
+        My::LocalSharedPtr<Tracker> copy = local;
+    }
+    other.join();
+
+    EXPECT_EQ(local.use_count(), 3);
+    local.reset();
+    local_copy.reset();
+    EXPECT_EQ(Tracker::destructed_count, 0);
+    shared.reset();
+    EXPECT_EQ(Tracker::destructed_count, 1);
+
+    static_assert(!std::is_convertible_v<My::LocalSharedPtr<int>, My::SharedPtr<int>>,
+                  "LocalSharedPtr -> SharedPtr must be explicit");
+}
+
+// 10. allocate_shared and pooled control blocks
+namespace {
+    struct AllocStats {
+        int allocations = 0;
+        int deallocations = 0;
+    };
+
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+        AllocStats* stats;
+
+        explicit CountingAllocator(AllocStats* s) : stats(s) {}
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>& other) : stats(other.stats) {}
+
+        T* allocate(size_t n) {
+            stats->allocations++;
+            return std::allocator<T>{}.allocate(n);
+        }
+        void deallocate(T* p, size_t n) {
+            stats->deallocations++;
+            std::allocator<T>{}.deallocate(p, n);
+        }
+        template<typename U>
+        bool operator==(const CountingAllocator<U>& other) const { return stats == other.stats; }
+    };
+
+    struct PooledOrder {
+        int id;
+        explicit PooledOrder(int i) : id(i) {}
+    };
+}
+
+template<>
+struct My::pooled_control_block<PooledOrder> : std::true_type {};
+
+TEST_F(SharedPtrTest, AllocateSharedUsesAllocator) {
+    AllocStats stats;
+    My::WeakPtr<Tracker> weak;
+    {
+        auto p = My::allocate_shared<Tracker>(CountingAllocator<Tracker>(&stats), 42);
+        EXPECT_EQ(stats.allocations, 1); // Block and object together
+        EXPECT_EQ(p->value, 42);
+        weak = p;
+        auto q = p;
+        EXPECT_EQ(p.use_count(), 2);
+    }
+    EXPECT_EQ(Tracker::destructed_count, 1);
+    EXPECT_EQ(stats.deallocations, 0); // The WeakPtr still holds the block
+    weak.reset();
+    EXPECT_EQ(stats.deallocations, 1);
+
+    auto local = My::allocate_local_shared<Tracker>(CountingAllocator<Tracker>(&stats), 1);
+    local.reset();
+    EXPECT_EQ(stats.allocations, 2);
+    EXPECT_EQ(stats.deallocations, 2);
+}
+
+TEST_F(SharedPtrTest, AllocateSharedPmrPassesResource) {
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::polymorphic_allocator<std::pmr::string> alloc(&arena);
+    auto p = My::allocate_shared<std::pmr::string>(alloc, "a string long enough to allocate its buffer");
+    EXPECT_EQ(p->get_allocator().resource(), &arena);
+}
+
+TEST_F(SharedPtrTest, PooledControlBlocksComeFromPool) {
+    using Pool = My::FixedBlockPool<sizeof(My::AllocationBlock<PooledOrder>), alignof(My::AllocationBlock<PooledOrder>)>;
+    {
+        auto warm = My::make_shared<PooledOrder>(0); // Make sure the cache has blocks
+    }
+    const size_t cached = Pool::instance().cached();
+    ASSERT_GT(cached, 0u);
+    {
+        auto p = My::make_shared<PooledOrder>(1);
+        EXPECT_EQ(Pool::instance().cached(), cached - 1);
+        auto q = p;
+        EXPECT_EQ(q->id, 1);
+    }
+    EXPECT_EQ(Pool::instance().cached(), cached); // Back in the thread cache
+
+    My::SharedPtr<PooledOrder> raw(new PooledOrder(2)); // DefaultControlBlock, pooled too
+    My::WeakPtr<PooledOrder> weak(raw);
+    raw.reset();
+    EXPECT_TRUE(weak.expired());
+}
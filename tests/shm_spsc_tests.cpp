@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "queues/ShmSpscRing.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+class ShmSpscRingTest : public ::testing::Test {
+protected:
+    // Unique per test process so parallel ctest runs do not collide
+    std::string name = "/my_shm_spsc_test." + std::to_string(getpid());
+
+    void TearDown() override {
+        My::ShmSpscRing<int>::remove(name);
+    }
+
+    // Waits for a fork()ed child and returns its exit code (-1 if it crashed)
+    static int join(pid_t child) {
+        int status = 0;
+        waitpid(child, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+};
+
+struct Tick {
+    uint64_t seq;
+    double price;
+};
+
+// 1. Basic Single-Process Logic
+TEST_F(ShmSpscRingTest, CreateAndAttachShareOneRing) {
+    auto producer = My::ShmSpscRing<int>::create(name, 3);
+    auto consumer = My::ShmSpscRing<int>::attach(name);
+    EXPECT_EQ(producer.capacity(), 4u); // Rounded up to a power of two
+    EXPECT_EQ(consumer.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(producer.push(i));
+    }
+    EXPECT_FALSE(producer.push(99));
+    EXPECT_TRUE(consumer.full());
+
+    int val;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(consumer.pop(val));
+        EXPECT_EQ(val, i);
+    }
+    EXPECT_FALSE(consumer.pop(val));
+    EXPECT_TRUE(producer.empty());
+}
+
+TEST_F(ShmSpscRingTest, BulkWrapsAround) {
+    auto producer = My::ShmSpscRing<int>::create(name, 8);
+    auto consumer = My::ShmSpscRing<int>::attach(name);
+    int in[6] = {0, 1, 2, 3, 4, 5};
+    int out[8];
+
+    EXPECT_EQ(producer.push_bulk(in, 6), 6u);
+    EXPECT_EQ(consumer.pop_bulk(out, 4), 4u);
+    EXPECT_EQ(producer.push_bulk(in, 6), 6u); // Wraps
+    EXPECT_EQ(producer.push_bulk(in, 6), 0u); // Full
+
+    EXPECT_EQ(consumer.pop_bulk(out, 8), 8u);
+    const int expected[8] = {4, 5, 0, 1, 2, 3, 4, 5};
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(out[i], expected[i]);
+    }
+}
+
+TEST_F(ShmSpscRingTest, BulkOfNothing) {
+    auto ring = My::ShmSpscRing<int>::create(name, 4);
+    EXPECT_EQ(ring.push_bulk(nullptr, 0), 0u);
+    EXPECT_EQ(ring.pop_bulk(nullptr, 0), 0u);
+    int in[4] = {1, 2, 3, 4};
+    EXPECT_EQ(ring.push_bulk(in, 4), 4u);
+    EXPECT_EQ(ring.push_bulk(in, 1), 0u); // Full
+    EXPECT_EQ(ring.pop_bulk(nullptr, 0), 0u);
+    EXPECT_EQ(ring.size(), 4u);
+}
+
+// 2. Attach Validation
+TEST_F(ShmSpscRingTest, AttachRejectsDifferentElementType) {
+    auto ring = My::ShmSpscRing<int>::create(name, 4);
+    EXPECT_THROW(My::ShmSpscRing<Tick>::attach(name), std::runtime_error);
+}
+
+TEST_F(ShmSpscRingTest, CreateAndAttachReportMissingOrExisting) {
+    EXPECT_THROW(My::ShmSpscRing<int>::attach(name), std::system_error);
+    auto ring = My::ShmSpscRing<int>::create(name, 4);
+    EXPECT_THROW(My::ShmSpscRing<int>::create(name, 4), std::system_error);
+}
+
+TEST_F(ShmSpscRingTest, FailedCreateReleasesTheName) {
+    //Far too large to map: initialise throws after shm_open created the name
+    EXPECT_THROW(My::ShmSpscRing<int>::create(name, size_t(1) << 60), std::system_error);
+    EXPECT_THROW(My::ShmSpscRing<int>::attach(name), std::system_error);
+    EXPECT_NO_THROW(My::ShmSpscRing<int>::create(name, 4));
+}
+
+// 3. Roles
+TEST_F(ShmSpscRingTest, LiveRoleCannotBeClaimedTwice) {
+    auto a = My::ShmSpscRing<int>::create(name, 4);
+    auto b = My::ShmSpscRing<int>::attach(name);
+    a.claim(My::ShmRole::Producer);
+    b.claim(My::ShmRole::Consumer);
+    EXPECT_TRUE(a.peer_alive());
+
+    auto c = My::ShmSpscRing<int>::attach(name);
+    EXPECT_THROW(c.claim(My::ShmRole::Producer), std::runtime_error);
+}
+
+// 4. Across Processes
+TEST_F(ShmSpscRingTest, ForkedProducerStreamsInOrder) {
+    const uint64_t N = 20000;
+    auto ring = My::ShmSpscRing<Tick>::create_anonymous(64);
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ring.claim(My::ShmRole::Producer);
+        for (uint64_t i = 0; i < N; ++i) {
+            while (!ring.push(Tick{i, i * 0.5})) {}
+        }
+        _exit(0);
+    }
+
+    ring.claim(My::ShmRole::Consumer);
+    Tick t;
+    bool in_order = true;
+    for (uint64_t i = 0; i < N; ++i) {
+        while (!ring.pop(t)) {}
+        in_order &= (t.seq == i && t.price == i * 0.5);
+    }
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(join(child), 0);
+}
+
+TEST_F(ShmSpscRingTest, SurvivorDrainsAndTakesOverAfterPeerDies) {
+    auto ring = My::ShmSpscRing<int>::create(name, 16);
+    ring.claim(My::ShmRole::Consumer);
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        auto producer = My::ShmSpscRing<int>::attach(name);
+        producer.claim(My::ShmRole::Producer);
+        for (int i = 0; i < 10; ++i) {
+            producer.push(i);
+        }
+        _exit(0); // Dies without releasing its role
+    }
+    ASSERT_EQ(join(child), 0);
+
+    EXPECT_FALSE(ring.peer_alive());
+    int val;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring.pop(val));
+        EXPECT_EQ(val, i);
+    }
+    EXPECT_FALSE(ring.pop(val));
+
+    // The dead producer's role can be taken over
+    auto replacement = My::ShmSpscRing<int>::attach(name);
+    EXPECT_NO_THROW(replacement.claim(My::ShmRole::Producer));
+    EXPECT_TRUE(ring.peer_alive());
+    EXPECT_TRUE(replacement.push(10));
+    EXPECT_TRUE(ring.pop(val));
+    EXPECT_EQ(val, 10);
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "algorithms/Simd.h"
+#include "memory/Array.h"
+#include "memory/Vector.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+class SimdTest : public ::testing::Test {
+protected:
+    // Every build this CPU can run, Scalar first (the reference)
+    static std::vector<My::Isa> builds() {
+        std::vector<My::Isa> out{My::Isa::Scalar};
+        for (My::Isa isa : {My::Isa::Sse42, My::Isa::Avx2}) {
+            if (My::isa_supported(isa)) out.push_back(isa);
+        }
+        return out;
+    }
+
+    static constexpr My::Cmp kCmps[] = {My::Cmp::Eq, My::Cmp::Ne, My::Cmp::Lt,
+                                         My::Cmp::Le, My::Cmp::Gt, My::Cmp::Ge};
+
+    // Small values so Eq hits, negatives so signed compares are exercised
+    static std::vector<int64_t> random_ints(size_t n, uint32_t seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int64_t> dist(-50, 50);
+        std::vector<int64_t> v(n);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    }
+    static std::vector<double> random_doubles(size_t n, uint32_t seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> dist(-400, 400);
+        std::vector<double> v(n);
+        for (auto& x : v) x = dist(rng) * 0.25;  // exact in binary, so ties and Eq happen
+        return v;
+    }
+};
+
+// 1. Basic Logic
+TEST_F(SimdTest, ByHand) {
+    const std::vector<int64_t> v{5, 3, 9, 3, 9, 1, 7};
+
+    EXPECT_EQ(My::find_first(v, My::Cmp::Eq, int64_t(9)), 2u);
+    EXPECT_EQ(My::find_first(v, My::Cmp::Ge, int64_t(6)), 2u);
+    EXPECT_EQ(My::find_first(v, My::Cmp::Lt, int64_t(2)), 5u);
+    EXPECT_EQ(My::find_first(v, My::Cmp::Gt, int64_t(100)), v.size());
+    EXPECT_EQ(My::count_matching(v, My::Cmp::Eq, int64_t(3)), 2u);
+    EXPECT_EQ(My::count_matching(v, My::Cmp::Ne, int64_t(3)), 5u);
+
+    //Ties report the first index
+    EXPECT_EQ(My::min_element(v).value, 1);
+    EXPECT_EQ(My::min_element(v).index, 5u);
+    EXPECT_EQ(My::max_element(v).value, 9);
+    EXPECT_EQ(My::max_element(v).index, 2u);
+
+    EXPECT_EQ(My::sum(v), 37);
+    EXPECT_EQ(My::dot(v, v), 25 + 9 + 81 + 9 + 81 + 1 + 49);
+}
+
+TEST_F(SimdTest, EmptyRange) {
+    const std::vector<double> empty;
+    EXPECT_EQ(My::find_first(empty, My::Cmp::Eq, 1.0), 0u);
+    EXPECT_EQ(My::count_matching(empty, My::Cmp::Eq, 1.0), 0u);
+    EXPECT_EQ(My::min_element(empty).index, 0u);
+    EXPECT_EQ(My::max_element(empty).index, 0u);
+    EXPECT_EQ(My::sum(empty), 0.0);
+    EXPECT_EQ(My::dot(empty, empty), 0.0);
+}
+
+// 2. Containers: anything contiguous with data()/size()
+TEST_F(SimdTest, AcceptsVectorArrayAndSpan) {
+    My::Vector<double> vec;
+    My::Array<double, 6> arr{};
+    for (size_t i = 0; i < 6; i++) {
+        vec.push_back(double(i));
+        arr[i] = double(i);
+    }
+    const std::span<const double> span(vec.data(), vec.size());
+
+    EXPECT_EQ(My::sum(vec), 15.0);
+    EXPECT_EQ(My::sum(arr), 15.0);
+    EXPECT_EQ(My::sum(span), 15.0);
+    EXPECT_EQ(My::find_first(arr, My::Cmp::Ge, 3.5), 4u);
+    EXPECT_EQ(My::max_element(vec).index, 5u);
+    EXPECT_EQ(My::dot(vec, arr), 55.0);
+    //Sub-range through a span
+    EXPECT_EQ(My::sum(span.subspan(2, 2)), 5.0);
+}
+
+// 3. Every build against Scalar, over all lengths around the vector widths
+// and all tail sizes
+TEST_F(SimdTest, IntBuildsMatchScalar) {
+    const auto& ref = My::simd_kernels<int64_t>(My::Isa::Scalar);
+    for (My::Isa isa : builds()) {
+        const auto& k = My::simd_kernels<int64_t>(isa);
+        ASSERT_EQ(k.isa, isa);
+        for (size_t n = 0; n <= 70; n++) {
+            const auto v = random_ints(n, uint32_t(n));
+            const auto w = random_ints(n, uint32_t(n + 1000));
+            for (My::Cmp cmp : kCmps) {
+                for (int64_t value : {-60, -3, 0, 17, 60}) {
+                    EXPECT_EQ(k.find_first(v.data(), n, cmp, value), ref.find_first(v.data(), n, cmp, value));
+                    EXPECT_EQ(k.count_matching(v.data(), n, cmp, value), ref.count_matching(v.data(), n, cmp, value));
+                }
+            }
+            EXPECT_EQ(k.min_element(v.data(), n).index, ref.min_element(v.data(), n).index) << "n=" << n;
+            EXPECT_EQ(k.max_element(v.data(), n).index, ref.max_element(v.data(), n).index) << "n=" << n;
+            EXPECT_EQ(k.sum(v.data(), n), ref.sum(v.data(), n));
+            EXPECT_EQ(k.dot(v.data(), w.data(), n), ref.dot(v.data(), w.data(), n));
+        }
+    }
+}
+
+TEST_F(SimdTest, DoubleBuildsMatchScalar) {
+    const auto& ref = My::simd_kernels<double>(My::Isa::Scalar);
+    for (My::Isa isa : builds()) {
+        const auto& k = My::simd_kernels<double>(isa);
+        for (size_t n = 0; n <= 70; n++) {
+            const auto v = random_doubles(n, uint32_t(n));
+            const auto w = random_doubles(n, uint32_t(n + 1000));
+            for (My::Cmp cmp : kCmps) {
+                for (double value : {-200.0, -0.25, 0.0, 33.5, 200.0}) {
+                    EXPECT_EQ(k.find_first(v.data(), n, cmp, value), ref.find_first(v.data(), n, cmp, value));
+                    EXPECT_EQ(k.count_matching(v.data(), n, cmp, value), ref.count_matching(v.data(), n, cmp, value));
+                }
+            }
+            const auto mn = k.min_element(v.data(), n);
+            const auto mx = k.max_element(v.data(), n);
+            EXPECT_EQ(mn.index, ref.min_element(v.data(), n).index) << "n=" << n;
+            EXPECT_EQ(mx.index, ref.max_element(v.data(), n).index) << "n=" << n;
+            if (n > 0) {
+                EXPECT_EQ(mn.value, v[mn.index]);
+                EXPECT_EQ(mx.value, v[mx.index]);
+            }
+            //Reassociated: equal up to rounding
+            EXPECT_NEAR(k.sum(v.data(), n), ref.sum(v.data(), n), 1e-9);
+            EXPECT_NEAR(k.dot(v.data(), w.data(), n), ref.dot(v.data(), w.data(), n), 1e-6);
+        }
+    }
+}
+
+// 4. Edge cases
+TEST_F(SimdTest, ExtremeIntsCompareSigned) {
+    const int64_t lo = std::numeric_limits<int64_t>::min();
+    const int64_t hi = std::numeric_limits<int64_t>::max();
+    const std::vector<int64_t> v{0, -1, hi, 1, lo, 2, 3, 4, 5};
+    for (My::Isa isa : builds()) {
+        const auto& k = My::simd_kernels<int64_t>(isa);
+        EXPECT_EQ(k.min_element(v.data(), v.size()).index, 4u);
+        EXPECT_EQ(k.max_element(v.data(), v.size()).index, 2u);
+        EXPECT_EQ(k.find_first(v.data(), v.size(), My::Cmp::Lt, int64_t(0)), 1u);
+        EXPECT_EQ(k.count_matching(v.data(), v.size(), My::Cmp::Gt, int64_t(0)), 6u);
+        //Wraps instead of overflowing
+        EXPECT_EQ(k.sum(v.data(), v.size()), int64_t(uint64_t(hi) + uint64_t(lo) + 14));
+    }
+}
+
+TEST_F(SimdTest, TiesReportFirstIndexAcrossLanes) {
+    //Same minimum in several lanes and blocks: earliest one wins
+    std::vector<double> v(37, 10.0);
+    v[30] = 1.0;
+    v[9] = 1.0;
+    v[22] = 1.0;
+    v[3] = 99.0;
+    v[33] = 99.0;
+    for (My::Isa isa : builds()) {
+        const auto& k = My::simd_kernels<double>(isa);
+        EXPECT_EQ(k.min_element(v.data(), v.size()).index, 9u);
+        EXPECT_EQ(k.max_element(v.data(), v.size()).index, 3u);
+    }
+}
+
+TEST_F(SimdTest, UnalignedStart) {
+    const auto v = random_doubles(100, 7);
+    const auto& ref = My::simd_kernels<double>(My::Isa::Scalar);
+    for (My::Isa isa : builds()) {
+        const auto& k = My::simd_kernels<double>(isa);
+        for (size_t offset = 1; offset < 4; offset++) {
+            const double* p = v.data() + offset;
+            const size_t n = v.size() - offset;
+            EXPECT_EQ(k.find_first(p, n, My::Cmp::Gt, 90.0), ref.find_first(p, n, My::Cmp::Gt, 90.0));
+            EXPECT_EQ(k.max_element(p, n).index, ref.max_element(p, n).index);
+        }
+    }
+}
+
+TEST_F(SimdTest, DispatchPicksBestSupported) {
+    EXPECT_EQ(My::simd_kernels<double>().isa, My::best_isa());
+    EXPECT_EQ(My::simd_kernels<int64_t>().isa, My::best_isa());
+    EXPECT_TRUE(My::isa_supported(My::Isa::Scalar));
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "memory/SmallVector.h"
+#include <memory>
+#include <string>
+
+using namespace My;
+
+// --- INLINE STORAGE ---
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+    SmallVector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 4);
+
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 4);
+
+    // The elements live inside the object itself
+    auto* self = reinterpret_cast<const std::byte*>(&v);
+    auto* first = reinterpret_cast<const std::byte*>(v.data());
+    EXPECT_TRUE(first >= self && first < self + sizeof(v));
+}
+
+TEST(SmallVectorTest, SpillsToHeapPastN) {
+    SmallVector<int, 4> v;
+    for (int i = 0; i < 5; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_GE(v.capacity(), 5);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+
+    v.clear(); // Keeps the heap block, like Vector keeps capacity
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(v.size(), 0);
+}
+
+TEST(SmallVectorTest, AccessorsMatchVector) {
+    SmallVector<std::string, 2> v;
+    v.emplace_back(3, 'a');
+    v.push_back("bb");
+    v.push_back("cc");
+
+    EXPECT_EQ(v.front(), "aaa");
+    EXPECT_EQ(v.back(), "cc");
+    EXPECT_EQ(v.at(1), "bb");
+    EXPECT_THROW(v.at(3), std::out_of_range);
+
+    std::string joined;
+    for (const auto& s : v) {
+        joined += s;
+    }
+    EXPECT_EQ(joined, "aaabbcc");
+    EXPECT_EQ(v.cend() - v.cbegin(), 3);
+    EXPECT_EQ(*v.cbegin(), "aaa");
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 2);
+}
+
+TEST(SmallVectorTest, PushOwnElementWhileSpilling) {
+    SmallVector<std::string, 2> v;
+    v.push_back(std::string(40, 'a'));
+    v.push_back(std::string(40, 'b'));
+    v.push_back(v[0]);
+    EXPECT_EQ(v[2], std::string(40, 'a'));
+}
+
+// --- MOVE SEMANTICS ---
+
+TEST(SmallVectorTest, MoveInlineRelocatesElements) {
+    SmallVector<std::unique_ptr<int>, 4> a;
+    a.push_back(std::make_unique<int>(1));
+    a.push_back(std::make_unique<int>(2));
+
+    SmallVector<std::unique_ptr<int>, 4> b(std::move(a));
+    EXPECT_TRUE(b.is_inline());
+    ASSERT_EQ(b.size(), 2);
+    EXPECT_EQ(*b[1], 2);
+    EXPECT_EQ(a.size(), 0);
+}
+
+TEST(SmallVectorTest, MoveHeapStealsBlock) {
+    SmallVector<int, 2> a;
+    for (int i = 0; i < 10; ++i) {
+        a.push_back(i);
+    }
+    int* block = a.data();
+
+    SmallVector<int, 2> b;
+    b.push_back(99);
+    b = std::move(a);
+    EXPECT_EQ(b.data(), block);
+    EXPECT_EQ(b.size(), 10);
+    EXPECT_TRUE(a.is_inline());
+    EXPECT_EQ(a.size(), 0);
+    a.push_back(7); // Moved-from is still usable
+    EXPECT_EQ(a[0], 7);
+}
+
+TEST(SmallVectorTest, DestroysEveryElement) {
+    auto counter = std::make_shared<int>(0);
+    {
+        SmallVector<std::shared_ptr<int>, 3> inline_only;
+        SmallVector<std::shared_ptr<int>, 3> spilled;
+        for (int i = 0; i < 2; ++i) inline_only.push_back(counter);
+        for (int i = 0; i < 6; ++i) spilled.push_back(counter);
+        EXPECT_EQ(counter.use_count(), 9);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "memory/SoaVector.h"
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+
+using namespace My;
+
+// --- COLUMNS ---
+
+TEST(SoaVectorTest, PushBackFillsEveryColumn) {
+    SoaVector<int64_t, uint32_t, char> orders;
+    EXPECT_TRUE(orders.empty());
+
+    for (int i = 0; i < 100; ++i) {
+        orders.push_back(1000 + i, static_cast<uint32_t>(i), (i % 2) ? 'B' : 'S');
+    }
+    EXPECT_EQ(orders.size(), 100);
+    EXPECT_GE(orders.capacity(), 100);
+
+    auto prices = orders.column<0>();
+    auto quantities = orders.column<1>();
+    EXPECT_EQ(prices.size(), 100);
+    EXPECT_EQ(std::accumulate(quantities.begin(), quantities.end(), uint64_t(0)), 4950);
+    EXPECT_EQ(prices[99], 1099);
+    EXPECT_EQ(orders.column<2>()[1], 'B');
+}
+
+TEST(SoaVectorTest, ColumnsAreContiguousAndCacheLineAligned) {
+    SoaVector<double, int32_t> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i * 0.5, i);
+    }
+    auto a = reinterpret_cast<uintptr_t>(v.column<0>().data());
+    auto b = reinterpret_cast<uintptr_t>(v.column<1>().data());
+    EXPECT_EQ(a % 64, 0);
+    EXPECT_EQ(b % 64, 0);
+    EXPECT_EQ(&v.column<0>()[9] - &v.column<0>()[0], 9);
+}
+
+// --- ROWS ---
+
+TEST(SoaVectorTest, RowProxyReadsAndWritesThroughToColumns) {
+    SoaVector<int, std::string> v;
+    v.push_back(1, "one");
+    v.emplace_back(2, "two");
+
+    auto [id, name] = v[1];
+    EXPECT_EQ(id, 2);
+    EXPECT_EQ(name, "two");
+
+    id = 20;                 // References into the columns
+    name += "!";
+    EXPECT_EQ(v.column<0>()[1], 20);
+    EXPECT_EQ(v.column<1>()[1], "two!");
+
+    v[0] = std::make_tuple(10, std::string("ten")); // Whole-row write
+    EXPECT_EQ(std::get<0>(v.front()), 10);
+    EXPECT_EQ(std::get<1>(v.front()), "ten");
+
+    const auto& cv = v;
+    EXPECT_EQ(std::get<1>(cv.back()), "two!");
+}
+
+TEST(SoaVectorTest, GrowthKeepsRowsIntact) {
+    SoaVector<std::string, int> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(std::to_string(i), i);
+    }
+    v.push_back(std::get<0>(v[0]), -1); // Own element, while growing
+    for (int i = 0; i < 1000; i += 111) {
+        EXPECT_EQ(std::get<0>(v[i]), std::to_string(i));
+        EXPECT_EQ(std::get<1>(v[i]), i);
+    }
+    EXPECT_EQ(std::get<0>(v.back()), "0");
+}
+
+// --- RESOURCE MANAGEMENT ---
+
+TEST(SoaVectorTest, DestroysEveryColumn) {
+    auto counter = std::make_shared<int>(0);
+    {
+        SoaVector<int, std::shared_ptr<int>> v;
+        for (int i = 0; i < 20; ++i) {
+            v.push_back(i, counter);
+        }
+        v.pop_back();
+        EXPECT_EQ(counter.use_count(), 20);
+
+        SoaVector<int, std::shared_ptr<int>> moved = std::move(v);
+        EXPECT_TRUE(v.empty());
+        EXPECT_EQ(moved.size(), 19);
+        EXPECT_EQ(counter.use_count(), 20);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
@@ -3,6 +3,9 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <string>
+#include <stdexcept>
+#include <chrono>
 
 class SpscRingTest : public ::testing::Test {};
 
@@ -106,3 +109,370 @@ TEST_F(SpscRingTest, MoveSemantics) {
     ASSERT_NE(out, nullptr);
     EXPECT_EQ(*out, 99);
 }
+
+// 4. Cached index must be refreshed, not trusted forever
+TEST_F(SpscRingTest, CachedIndexRefreshesAcrossLaps) {
+    // Tiny ring so both caches go stale on every lap
+    My::SpscRing<int> ring(3);
+    int val;
+
+    for (int lap = 0; lap < 10; ++lap) {
+        EXPECT_TRUE(ring.push(lap * 3 + 0));
+        EXPECT_TRUE(ring.push(lap * 3 + 1));
+        EXPECT_TRUE(ring.push(lap * 3 + 2));
+        EXPECT_FALSE(ring.push(-1)); // Full: producer refreshes head, still full
+
+        EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, lap * 3 + 0);
+        EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, lap * 3 + 1);
+        EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, lap * 3 + 2);
+        EXPECT_FALSE(ring.pop(val)); // Empty: consumer refreshes tail, still empty
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+// 5. Batch Operations
+TEST_F(SpscRingTest, BulkPushPopWrapsAround) {
+    My::SpscRing<int> ring(8);
+    int out[8] = {};
+
+    // Move the indices near the end so the next batch has to wrap
+    const int warmup[5] = {0, 1, 2, 3, 4};
+    EXPECT_EQ(ring.push_bulk(warmup, 5), 5u);
+    EXPECT_EQ(ring.pop_bulk(out, 5), 5u);
+
+    const int batch[8] = {10, 11, 12, 13, 14, 15, 16, 17};
+    EXPECT_EQ(ring.push_bulk(batch, 8), 8u);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.push_bulk(batch, 1), 0u); // Full
+
+    EXPECT_EQ(ring.pop_bulk(out, 8), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(out[i], 10 + i);
+    }
+    EXPECT_EQ(ring.pop_bulk(out, 1), 0u); // Empty
+}
+
+TEST_F(SpscRingTest, BulkIsPartialWhenShortOfSpace) {
+    My::SpscRing<int> ring(4);
+    const int batch[6] = {1, 2, 3, 4, 5, 6};
+    int out[6] = {};
+
+    EXPECT_EQ(ring.push_bulk(batch, 6), 4u);
+    EXPECT_EQ(ring.pop_bulk(out, 6), 4u);
+    EXPECT_EQ(out[3], 4);
+}
+
+TEST_F(SpscRingTest, BulkNonTrivialType) {
+    My::SpscRing<std::string> ring(3);
+    const std::string batch[3] = {"a", "bb", "a long string that will not fit in SSO"};
+    std::string out[3];
+
+    EXPECT_EQ(ring.push_bulk(batch, 3), 3u);
+    EXPECT_EQ(ring.pop_bulk(out, 3), 3u);
+    EXPECT_EQ(out[2], batch[2]);
+}
+
+namespace {
+    int g_live = 0;
+
+    // Counts live objects; the copy throws when the source asks it to
+    struct Counted {
+        int value = 0;
+        bool throw_on_copy = false;
+
+        Counted() { g_live++; }
+        explicit Counted(int v, bool t = false): value(v), throw_on_copy(t) { g_live++; }
+        Counted(const Counted& other): value(other.value) {
+            if (other.throw_on_copy) throw std::runtime_error("Counted");
+            g_live++;
+        }
+        Counted(Counted&& other) noexcept: value(other.value) { g_live++; }
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&&) noexcept = default;
+        ~Counted() { g_live--; }
+    };
+}
+
+TEST_F(SpscRingTest, BulkThrowInSecondRangeDestroysFirst) {
+    {
+        My::SpscRing<Counted> ring(4);
+        Counted out[4];
+        //Move the tail to slot 3 so the batch wraps: 1 item, then 2
+        const Counted warmup[3] = {Counted(0), Counted(1), Counted(2)};
+        EXPECT_EQ(ring.push_bulk(warmup, 3), 3u);
+        EXPECT_EQ(ring.pop_bulk(out, 3), 3u);
+
+        const int before = g_live;
+        const Counted batch[3] = {Counted(10), Counted(11), Counted(12, true)};
+        EXPECT_THROW(ring.push_bulk(batch, 3), std::runtime_error);
+        EXPECT_EQ(g_live, before + 3); // Only the batch itself
+        EXPECT_TRUE(ring.empty());
+
+        EXPECT_EQ(ring.push_bulk(batch, 2), 2u);
+        EXPECT_EQ(ring.pop_bulk(out, 4), 2u);
+        EXPECT_EQ(out[1].value, 11);
+    }
+    EXPECT_EQ(g_live, 0);
+}
+
+TEST_F(SpscRingTest, ReserveCommit) {
+    My::SpscRing<int> ring(4);
+    int val;
+
+    std::span<int> slots = ring.try_reserve(3);
+    ASSERT_EQ(slots.size(), 3u);
+    slots[0] = 7; slots[1] = 8; slots[2] = 9;
+
+    // Nothing is visible until commit
+    EXPECT_FALSE(ring.pop(val));
+    ring.commit(2);
+
+    EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, 7);
+    EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, 8);
+    EXPECT_FALSE(ring.pop(val)); // Third slot was reserved but never committed
+
+    // The span stops at the end of the buffer even if the ring has room
+    std::span<int> tail_slots = ring.try_reserve(4);
+    EXPECT_GE(tail_slots.size(), 1u);
+    EXPECT_LE(tail_slots.size(), 3u);
+    ring.commit(0);
+}
+
+TEST_F(SpscRingTest, BulkProducerConsumerStress) {
+    const int num_iterations = 1'000'000;
+    My::SpscRing<int> ring(1000);
+    std::vector<int> consumed_data;
+    consumed_data.reserve(num_iterations);
+
+    std::thread consumer([&]() {
+        int batch[64];
+        while (consumed_data.size() < num_iterations) {
+            const size_t n = ring.pop_bulk(batch, 64);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            consumed_data.insert(consumed_data.end(), batch, batch + n);
+        }
+    });
+
+    std::thread producer([&]() {
+        int batch[37];
+        int next = 0;
+        while (next < num_iterations) {
+            const int want = std::min(37, num_iterations - next);
+            for (int i = 0; i < want; ++i) {
+                batch[i] = next + i;
+            }
+            int sent = 0;
+            while (sent < want) {
+                const size_t n = ring.push_bulk(batch + sent, want - sent);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                sent += static_cast<int>(n);
+            }
+            next += want;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(consumed_data.size(), num_iterations);
+    for (int i = 0; i < num_iterations; ++i) {
+        ASSERT_EQ(consumed_data[i], i) << "Mismatch at index " << i;
+    }
+}
+
+// 6. Capacity modes and free-running indices
+TEST_F(SpscRingTest, NoSacrificialSlot) {
+    My::SpscRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 3u);
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.size(), 3u);
+}
+
+TEST_F(SpscRingTest, ZeroCapacity) {
+    My::SpscRing<int> ring(0);
+    int val;
+    EXPECT_FALSE(ring.push(1));
+    EXPECT_FALSE(ring.pop(val));
+    EXPECT_TRUE(ring.try_reserve(1).empty());
+    EXPECT_TRUE(ring.empty());
+    EXPECT_TRUE(ring.full());
+}
+
+TEST_F(SpscRingTest, PowerOfTwoRoundsUp) {
+    My::SpscRing<int, My::RingCapacity::PowerOfTwo> ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+
+    My::SpscRing<int, My::RingCapacity::PowerOfTwo> exact(16);
+    EXPECT_EQ(exact.capacity(), 16u);
+}
+
+TEST_F(SpscRingTest, PowerOfTwoWrapsManyLaps) {
+    My::SpscRing<int, My::RingCapacity::PowerOfTwo> ring(4);
+    int val;
+
+    // Size stays a plain tail - head subtraction as the sequences keep growing
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(ring.push(i));
+        EXPECT_TRUE(ring.push(i + 1));
+        EXPECT_EQ(ring.size(), 2u);
+        EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, i);
+        EXPECT_TRUE(ring.pop(val)); EXPECT_EQ(val, i + 1);
+        EXPECT_EQ(ring.size(), 0u);
+    }
+}
+
+TEST_F(SpscRingTest, PowerOfTwoProducerConsumerStress) {
+    const int num_iterations = 1'000'000;
+    My::SpscRing<int, My::RingCapacity::PowerOfTwo> ring(1000);
+    long long sum = 0;
+
+    std::thread consumer([&]() {
+        int val;
+        int expected = 0;
+        while (expected < num_iterations) {
+            if (ring.pop(val)) {
+                ASSERT_EQ(val, expected);
+                sum += val;
+                expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < num_iterations; ++i) {
+        while (!ring.push(i)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    EXPECT_EQ(sum, static_cast<long long>(num_iterations) * (num_iterations - 1) / 2);
+}
+
+// 7. Blocking layer
+TEST_F(SpscRingTest, PopWaitForTimesOutWhenEmpty) {
+    My::SpscRing<int> ring(4);
+    int val = -1;
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring.pop_wait_for(val, std::chrono::milliseconds(5)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(5));
+    EXPECT_EQ(val, -1);
+}
+
+TEST_F(SpscRingTest, PushWaitForTimesOutWhenFull) {
+    My::SpscRing<std::unique_ptr<int>> ring(1);
+    EXPECT_TRUE(ring.push(std::make_unique<int>(1)));
+
+    auto item = std::make_unique<int>(2);
+    EXPECT_FALSE(ring.push_wait_for(std::move(item), std::chrono::milliseconds(2)));
+    ASSERT_NE(item, nullptr); // Not consumed on timeout
+
+    std::unique_ptr<int> out;
+    EXPECT_TRUE(ring.pop_wait_for(out, std::chrono::milliseconds(2)));
+    EXPECT_TRUE(ring.push_wait_for(std::move(item), std::chrono::milliseconds(2)));
+    EXPECT_EQ(item, nullptr);
+}
+
+TEST_F(SpscRingTest, PopWaitWakesOnPush) {
+    // No spinning at all: the consumer parks straight away
+    My::SpscRing<int> ring(4, My::WaitPolicy{0, 0});
+    int val = 0;
+
+    std::thread consumer([&]() { ring.pop_wait(val); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ring.push_wait(42);
+    consumer.join();
+
+    EXPECT_EQ(val, 42);
+}
+
+TEST_F(SpscRingTest, BlockingProducerConsumerStress) {
+    // Tiny ring and no spin budget so both sides park constantly
+    const int num_iterations = 200'000;
+    My::SpscRing<int> ring(2, My::WaitPolicy{0, 1});
+    std::vector<int> consumed_data;
+    consumed_data.reserve(num_iterations);
+
+    std::thread consumer([&]() {
+        int val;
+        for (int i = 0; i < num_iterations; ++i) {
+            ring.pop_wait(val);
+            consumed_data.push_back(val);
+        }
+    });
+    for (int i = 0; i < num_iterations; ++i) {
+        ring.push_wait(i);
+    }
+    consumer.join();
+
+    ASSERT_EQ(consumed_data.size(), num_iterations);
+    for (int i = 0; i < num_iterations; ++i) {
+        ASSERT_EQ(consumed_data[i], i) << "Mismatch at index " << i;
+    }
+}
+
+// 8. Slot storage
+struct NoDefault {
+    static int alive;
+    int value;
+
+    explicit NoDefault(int v) : value(v) { alive++; }
+    NoDefault(const NoDefault& o) : value(o.value) { alive++; }
+    NoDefault(NoDefault&& o) noexcept : value(o.value) { alive++; }
+    NoDefault& operator=(const NoDefault&) = default;
+    NoDefault& operator=(NoDefault&&) noexcept = default;
+    ~NoDefault() { alive--; }
+};
+int NoDefault::alive = 0;
+
+TEST_F(SpscRingTest, NonDefaultConstructibleType) {
+    NoDefault::alive = 0;
+    {
+        My::SpscRing<NoDefault> ring(4);
+        EXPECT_EQ(NoDefault::alive, 0); // No slot is constructed up front
+
+        EXPECT_TRUE(ring.push(NoDefault(1)));
+        EXPECT_TRUE(ring.push(NoDefault(2)));
+        EXPECT_EQ(NoDefault::alive, 2);
+
+        NoDefault out(0);
+        EXPECT_TRUE(ring.pop(out));
+        EXPECT_EQ(out.value, 1);
+        EXPECT_EQ(NoDefault::alive, 2); // out + one left in the ring
+
+        const NoDefault batch[2] = {NoDefault(3), NoDefault(4)};
+        EXPECT_EQ(ring.push_bulk(batch, 2), 2u);
+        EXPECT_EQ(NoDefault::alive, 6);
+    }
+    // Ring destructor destroyed the three it still held
+    EXPECT_EQ(NoDefault::alive, 0);
+}
+
+TEST_F(SpscRingTest, HugePageBackedRing) {
+    // Falls back to a normal mapping (or the heap) when no huge pages are reserved
+    My::SpscRing<int, My::RingCapacity::PowerOfTwo> ring(1 << 16, {}, My::SlotMemory::HugePages);
+    int val;
+    for (int i = 0; i < (1 << 16); ++i) {
+        ASSERT_TRUE(ring.push(i));
+    }
+    EXPECT_TRUE(ring.full());
+    for (int i = 0; i < (1 << 16); ++i) {
+        ASSERT_TRUE(ring.pop(val));
+        ASSERT_EQ(val, i);
+    }
+}
+
+TEST_F(SpscRingTest, SlotsAreCacheLineAligned) {
+    My::SlotArray<char> slots(3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(slots.data()) % My::kCacheLine, 0u);
+    EXPECT_EQ(alignof(My::SpscRing<char>), 64u);
+}
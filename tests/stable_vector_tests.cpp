@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "memory/StableVector.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace My;
+
+// --- BASICS ---
+
+TEST(StableVectorTest, PushAndIndexAcrossChunks) {
+    StableVector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 0);
+
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v.size(), 10);
+    EXPECT_EQ(v.capacity(), 12); // Three chunks of 4
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 9);
+    EXPECT_THROW(v.at(10), std::out_of_range);
+}
+
+TEST(StableVectorTest, DefaultChunkSizeIsPowerOfTwo) {
+    EXPECT_EQ(StableVector<double>::kChunkSize, 2048);
+    EXPECT_EQ(StableVector<char>::kChunkSize, 16384);
+    struct Big { char bytes[100000]; };
+    EXPECT_EQ(StableVector<Big>::kChunkSize, 1);
+}
+
+// --- STABILITY ---
+
+TEST(StableVectorTest, AppendsNeverMoveElements) {
+    StableVector<std::string, 8> v;
+    v.push_back("first");
+    const std::string* first = &v[0];
+    const char* first_chars = v[0].data();
+
+    std::vector<const std::string*> addresses;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(std::to_string(i));
+        addresses.push_back(&v.back());
+    }
+    EXPECT_EQ(&v[0], first);
+    EXPECT_EQ(v[0].data(), first_chars); // Not even moved (SSO buffer would change)
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(addresses[i], &v[i + 1]);
+        EXPECT_EQ(v[i + 1], std::to_string(i));
+    }
+}
+
+TEST(StableVectorTest, PushOwnElementWhenAddingChunk) {
+    StableVector<std::string, 2> v;
+    v.push_back("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"); // Heap allocated string
+    v.push_back("b");
+    v.push_back(v[0]); // Needs a new chunk; v[0] must stay valid
+    EXPECT_EQ(v[2], v[0]);
+}
+
+TEST(StableVectorTest, MoveKeepsElementAddresses) {
+    StableVector<int, 4> a;
+    for (int i = 0; i < 9; ++i) {
+        a.push_back(i);
+    }
+    const int* p = &a[5];
+
+    StableVector<int, 4> b(std::move(a));
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_EQ(&b[5], p);
+
+    StableVector<int, 4> c;
+    c.push_back(42);
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 9);
+    EXPECT_EQ(&c[5], p);
+}
+
+// --- CHUNKS ---
+
+TEST(StableVectorTest, ChunkSpansCoverAllElements) {
+    StableVector<int64_t, 8> v;
+    EXPECT_EQ(v.chunk_count(), 0);
+    for (int64_t i = 0; i < 21; ++i) {
+        v.push_back(i);
+    }
+    ASSERT_EQ(v.chunk_count(), 3);
+    EXPECT_EQ(v.chunk(0).size(), 8);
+    EXPECT_EQ(v.chunk(2).size(), 5); // Last chunk is partial
+
+    int64_t sum = 0;
+    int64_t expected = 0;
+    for (size_t c = 0; c < v.chunk_count(); ++c) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(v.chunk(c).data()) % 64, 0); // Cache-line aligned
+        for (int64_t x : v.chunk(c)) {
+            EXPECT_EQ(x, expected++);
+            sum += x;
+        }
+    }
+    EXPECT_EQ(sum, 20 * 21 / 2);
+}
+
+// --- ITERATORS ---
+
+TEST(StableVectorTest, IteratorsWorkWithAlgorithms) {
+    StableVector<int, 4> v;
+    for (int i = 9; i >= 0; --i) {
+        v.push_back(i);
+    }
+    std::sort(v.begin(), v.end());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(std::accumulate(v.cbegin(), v.cend(), 0), 45);
+    EXPECT_EQ(v.end() - v.begin(), 10);
+    EXPECT_EQ(*(v.begin() + 6), 6);
+
+    const auto& cv = v;
+    EXPECT_EQ(std::count_if(cv.begin(), cv.end(), [](int x) { return x % 2 == 0; }), 5);
+    StableVector<int, 4>::const_iterator it = v.begin(); // iterator -> const_iterator
+    EXPECT_EQ(*it, 0);
+}
+
+// --- LIFETIME ---
+
+TEST(StableVectorTest, PopClearAndShrink) {
+    auto counter = std::make_shared<int>(0);
+    StableVector<std::shared_ptr<int>, 4> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(counter);
+    }
+    EXPECT_EQ(counter.use_count(), 11);
+
+    v.pop_back();
+    EXPECT_EQ(counter.use_count(), 10);
+    EXPECT_EQ(v.size(), 9);
+
+    v.clear(); // Keeps the chunks
+    EXPECT_EQ(counter.use_count(), 1);
+    EXPECT_EQ(v.capacity(), 12);
+
+    v.push_back(counter);
+    v.shrink_to_fit(); // Frees the two empty chunks
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_EQ(*v[0], 0);
+}
+
+TEST(StableVectorTest, ReserveAllocatesWholeChunks) {
+    StableVector<int, 16> v;
+    v.reserve(17);
+    EXPECT_EQ(v.capacity(), 32);
+    const size_t cap = v.capacity();
+    for (int i = 0; i < 32; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v.capacity(), cap);
+}
+
+TEST(StableVectorTest, DestructorDestroysEverything) {
+    auto counter = std::make_shared<int>(0);
+    {
+        StableVector<std::shared_ptr<int>, 2> v;
+        for (int i = 0; i < 7; ++i) {
+            v.push_back(counter);
+        }
+        EXPECT_EQ(counter.use_count(), 8);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
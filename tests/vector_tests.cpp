@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
 #include "memory/Vector.h"
 #include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+#include <vector>
 
 using namespace My;
 
@@ -129,7 +140,6 @@ TEST(VectorTest, EmplaceBackEfficiency) {
     EXPECT_EQ(ref.x, 10);
 }
 
-/*
 // --- MOVE SEMANTICS ---
 
 TEST(VectorTest, MoveConstructor) {
@@ -147,4 +157,334 @@ TEST(VectorTest, MoveConstructor) {
     EXPECT_EQ(v1.data(), nullptr);
     EXPECT_EQ(v1.size(), 0);
 }
-*/
+
+
+// --- GROWTH POLICY & RELOCATION ---
+
+// Not trivially copyable (counts its moves), but opted in as relocatable
+struct Relocatable {
+    static int moves;
+    int val;
+
+    Relocatable(int v) : val(v) {}
+    Relocatable(Relocatable&& o) noexcept : val(o.val) { moves++; }
+    ~Relocatable() {}
+};
+int Relocatable::moves = 0;
+
+template <>
+struct My::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+// Move constructor may throw: growth must copy instead
+struct ThrowingMove {
+    static int copies;
+    static int moves;
+    int val;
+
+    ThrowingMove(int v) : val(v) {}
+    ThrowingMove(const ThrowingMove& o) : val(o.val) { copies++; }
+    ThrowingMove(ThrowingMove&& o) : val(o.val) { moves++; }
+};
+int ThrowingMove::copies = 0;
+int ThrowingMove::moves = 0;
+
+TEST(VectorTest, GrowthPolicies) {
+    auto capacities = [](auto& v) {
+        std::vector<size_t> seen;
+        for (int i = 0; i < 20; ++i) {
+            v.push_back(i);
+            if (seen.empty() || seen.back() != v.capacity()) {
+                seen.push_back(v.capacity());
+            }
+        }
+        return seen;
+    };
+
+    Vector<int> doubling;
+    Vector<int, GrowOneAndHalf> one_and_half;
+    Vector<int, GrowExact> exact;
+
+    EXPECT_EQ(capacities(doubling), (std::vector<size_t>{2, 4, 8, 16, 32}));
+    EXPECT_EQ(capacities(one_and_half), (std::vector<size_t>{2, 3, 4, 6, 9, 13, 19, 28}));
+    EXPECT_EQ(exact.capacity(), 0);
+    capacities(exact);
+    EXPECT_EQ(exact.capacity(), 20);
+}
+
+TEST(VectorTest, RelocatableTypesAreMemcpyed) {
+    static_assert(is_trivially_relocatable_v<int>);
+    static_assert(!is_trivially_relocatable_v<std::string>);
+
+    Relocatable::moves = 0;
+    Vector<Relocatable> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i);
+    }
+    EXPECT_EQ(Relocatable::moves, 0); // Never moved element by element
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(v[i].val, i);
+    }
+}
+
+TEST(VectorTest, ThrowingMoveFallsBackToCopy) {
+    ThrowingMove::copies = 0;
+    ThrowingMove::moves = 0;
+    Vector<ThrowingMove> v;
+    v.reserve(2);
+    v.emplace_back(1);
+    v.emplace_back(2);
+    v.reserve(4);
+
+    EXPECT_EQ(ThrowingMove::moves, 0);
+    EXPECT_EQ(ThrowingMove::copies, 2);
+    EXPECT_EQ(v[1].val, 2);
+}
+
+TEST(VectorTest, NonTrivialTypesRelocateByMove) {
+    Vector<std::string> v;
+    for (int i = 0; i < 50; ++i) {
+        v.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    EXPECT_EQ(v[49], std::string(40, 'x'));
+}
+
+TEST(VectorTest, PushBackOwnElementWhileGrowing) {
+    Vector<std::string> v;
+    v.push_back(std::string(40, 'a'));
+    v.push_back(std::string(40, 'b'));
+    ASSERT_EQ(v.size(), v.capacity()); // Next push reallocates
+
+    v.push_back(v[0]);
+    EXPECT_EQ(v[2], std::string(40, 'a'));
+}
+
+// --- ALLOCATORS ---
+
+// Stateful allocator that counts its blocks; never propagates on move assignment
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::false_type;
+    using is_always_equal = std::false_type;
+
+    int* live_blocks;
+
+    explicit CountingAllocator(int* counter) : live_blocks(counter) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& o) : live_blocks(o.live_blocks) {}
+
+    T* allocate(size_t n) { ++*live_blocks; return std::allocator<T>{}.allocate(n); }
+    void deallocate(T* p, size_t n) { --*live_blocks; std::allocator<T>{}.deallocate(p, n); }
+
+    bool operator==(const CountingAllocator& o) const { return live_blocks == o.live_blocks; }
+};
+
+TEST(VectorTest, DefaultAllocatorCostsNoSpace) {
+    EXPECT_EQ(sizeof(Vector<int>), sizeof(int*) + 2 * sizeof(size_t));
+}
+
+TEST(VectorTest, UsesTheGivenAllocator) {
+    int blocks = 0;
+    {
+        Vector<int, GrowDouble, CountingAllocator<int>> v{CountingAllocator<int>(&blocks)};
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        EXPECT_EQ(blocks, 1); // Old blocks are handed back as it grows
+        EXPECT_EQ(v.get_allocator().live_blocks, &blocks);
+    }
+    EXPECT_EQ(blocks, 0);
+}
+
+TEST(VectorTest, MoveConstructorStealsBlockAndAllocator) {
+    int blocks = 0;
+    Vector<int, GrowDouble, CountingAllocator<int>> a{CountingAllocator<int>(&blocks)};
+    a.push_back(1);
+    int* block = a.data();
+
+    auto b = std::move(a);
+    EXPECT_EQ(b.data(), block);
+    EXPECT_EQ(b.size(), 1);
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_EQ(blocks, 1);
+}
+
+TEST(VectorTest, MoveAssignAcrossUnequalAllocatorsMovesElements) {
+    int blocks_a = 0;
+    int blocks_b = 0;
+    Vector<std::string, GrowDouble, CountingAllocator<std::string>> a{CountingAllocator<std::string>(&blocks_a)};
+    Vector<std::string, GrowDouble, CountingAllocator<std::string>> b{CountingAllocator<std::string>(&blocks_b)};
+    a.push_back("one");
+    a.push_back("two");
+    std::string* a_block = a.data();
+
+    b = std::move(a);
+    EXPECT_NE(b.data(), a_block);            // b kept its own resource
+    EXPECT_EQ(b.get_allocator().live_blocks, &blocks_b);
+    ASSERT_EQ(b.size(), 2);
+    EXPECT_EQ(b[1], "two");
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_EQ(blocks_b, 1);
+}
+
+TEST(VectorTest, PmrVectorOnMonotonicArena) {
+    std::byte arena[4096];
+    std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+
+    My::pmr::Vector<int> v(&resource);
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    auto* first = reinterpret_cast<std::byte*>(v.data());
+    EXPECT_TRUE(first >= arena && first < arena + sizeof(arena)); // Never touched the heap
+    EXPECT_EQ(v[99], 99);
+
+    // Elements that are themselves pmr-aware get the same resource
+    My::pmr::Vector<std::pmr::string> names(&resource);
+    names.emplace_back("a string long enough to need its own allocation");
+    EXPECT_EQ(names[0].get_allocator().resource(), &resource);
+}
+
+TEST(VectorTest, MoveAssignmentAndReturnByValue) {
+    auto make = []() {
+        Vector<std::string> v;
+        v.push_back("x");
+        v.push_back("y");
+        return v;
+    };
+    Vector<std::string> v = make();
+    EXPECT_EQ(v.size(), 2);
+
+    Vector<std::string> w;
+    w.push_back("old");
+    w = std::move(v);
+    EXPECT_EQ(w[1], "y");
+    EXPECT_TRUE(v.empty());
+}
+
+// --- ITERATORS & BULK OPERATIONS ---
+
+TEST(VectorTest, RangeForAndIterators) {
+    Vector<int> v;
+    for (int i = 1; i <= 4; ++i) v.push_back(i);
+
+    int sum = 0;
+    for (int x : v) sum += x;
+    EXPECT_EQ(sum, 10);
+    EXPECT_EQ(v.end() - v.begin(), 4);
+    EXPECT_EQ(*std::find(v.cbegin(), v.cend(), 3), 3);
+}
+
+TEST(VectorTest, AppendReservesOnce) {
+    int blocks = 0;
+    Vector<int, GrowExact, CountingAllocator<int>> v{CountingAllocator<int>(&blocks)};
+    std::vector<int> src(1000);
+    std::iota(src.begin(), src.end(), 0);
+
+    v.append(src.begin(), src.end());
+    EXPECT_EQ(v.size(), 1000);
+    EXPECT_EQ(v.capacity(), 1000); // One exact block, not a chain of doublings
+    EXPECT_EQ(v[999], 999);
+
+    // Non-contiguous and input-only ranges work too
+    std::list<int> more{1, 2, 3};
+    v.append(more.begin(), more.end());
+    std::istringstream words("7 8 9");
+    v.append(std::istream_iterator<int>(words), std::istream_iterator<int>());
+    EXPECT_EQ(v.size(), 1006);
+    EXPECT_EQ(v.back(), 9);
+}
+
+TEST(VectorTest, AppendOwnElementsWhileGrowing) {
+    Vector<std::string> v;
+    v.push_back(std::string(40, 'a'));
+    v.push_back(std::string(40, 'b'));
+    v.append(v.begin(), v.end()); // Source is invalidated by the growth
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[2], std::string(40, 'a'));
+    EXPECT_EQ(v[3], std::string(40, 'b'));
+}
+
+TEST(VectorTest, AssignReplacesContents) {
+    Vector<std::string> v;
+    v.push_back("gone");
+    const char* words[] = {"a", "b", "c"};
+    v.assign(std::begin(words), std::end(words));
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], "a");
+    EXPECT_EQ(v[2], "c");
+}
+
+TEST(VectorTest, InsertAndErase) {
+    Vector<int> v;
+    for (int i = 0; i < 5; ++i) v.push_back(i); // 0 1 2 3 4
+
+    auto it = v.insert(v.begin() + 2, 42);       // 0 1 42 2 3 4
+    EXPECT_EQ(*it, 42);
+    int extra[] = {7, 8};
+    it = v.insert(v.begin(), std::begin(extra), std::end(extra)); // 7 8 0 1 42 2 3 4
+    EXPECT_EQ(it, v.begin());
+    v.insert(v.end(), 2, -1);                    // ... 4 -1 -1
+    v.emplace(v.begin() + 1, 5);                 // 7 5 8 0 1 42 2 3 4 -1 -1
+
+    std::vector<int> got(v.begin(), v.end());
+    EXPECT_EQ(got, (std::vector<int>{7, 5, 8, 0, 1, 42, 2, 3, 4, -1, -1}));
+
+    it = v.erase(v.begin() + 1);                 // 7 8 0 1 42 2 3 4 -1 -1
+    EXPECT_EQ(*it, 8);
+    it = v.erase(v.begin() + 2, v.begin() + 5);  // 7 8 2 3 4 -1 -1
+    EXPECT_EQ(*it, 2);
+    got.assign(v.begin(), v.end());
+    EXPECT_EQ(got, (std::vector<int>{7, 8, 2, 3, 4, -1, -1}));
+}
+
+TEST(VectorTest, EraseDestroysRemovedElements) {
+    auto counter = std::make_shared<int>(0);
+    {
+        Vector<std::shared_ptr<int>> v;
+        for (int i = 0; i < 6; ++i) v.push_back(counter);
+        v[4] = nullptr;
+        v.erase(v.begin() + 1, v.begin() + 4);
+        ASSERT_EQ(v.size(), 3);
+        EXPECT_EQ(v[1], nullptr); // Old v[4] slid down
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(VectorTest, ResizeValueInitialisesAndShrinks) {
+    Vector<int> v;
+    v.push_back(5);
+    v.resize(4);
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[0], 5);
+    EXPECT_EQ(v[3], 0);
+
+    v.resize(6, 9);
+    EXPECT_EQ(v[5], 9);
+    v.resize(2);
+    EXPECT_EQ(v.size(), 2);
+}
+
+TEST(VectorTest, ResizeForOverwriteThenFill) {
+    Vector<uint8_t> buffer;
+    buffer.resize_for_overwrite(256);
+    ASSERT_EQ(buffer.size(), 256);
+    std::memset(buffer.data(), 0xAB, buffer.size());
+    EXPECT_EQ(buffer[255], 0xAB);
+}
+
+TEST(VectorTest, ShrinkToFit) {
+    Vector<int> v;
+    v.reserve(100);
+    v.push_back(1);
+    v.push_back(2);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 2);
+    EXPECT_EQ(v[1], 2);
+
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0);
+    EXPECT_EQ(v.data(), nullptr);
+}